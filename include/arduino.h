@@ -0,0 +1,77 @@
+/** @file arduino.h
+ * @brief Interrupt-driven ball classification from the on-board Arduino
+ *
+ * The Arduino reports each ball it classifies as one HIGH pulse on ARDUINO_SENS_OUT. The pulse
+ * width encodes the team: a pulse shorter than ARDUINO_ENEMY_PULSE_US is a friendly ball, a
+ * longer one is an enemy ball. Pulses shorter than ARDUINO_MIN_PULSE_US are treated as noise.
+ *
+ * Both edges are captured by a pin-change interrupt and timed with micros(), so a ball is
+ * classified the moment its pulse ends instead of at the next control cycle. Classified balls
+ * are queued in a lock-free ring (the interrupt handler is the only producer) until the
+ * sorter takes them with arduinoPoll().
+ */
+
+#ifndef ARDUINO_H_
+#define ARDUINO_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of classified balls that can wait for the sorter. Must be a power of two.
+ */
+#define ARDUINO_QUEUE_SIZE 8
+/**
+ * Pulses shorter than this many microseconds are ignored as noise.
+ */
+#define ARDUINO_MIN_PULSE_US 200
+/**
+ * Pulses at least this many microseconds long mark an enemy ball.
+ */
+#define ARDUINO_ENEMY_PULSE_US 2000
+
+/**
+ * A ball classified by the Arduino.
+ */
+typedef struct {
+	// micros() at the falling edge that completed the classification
+	unsigned long time;
+	// Width of the classification pulse in microseconds
+	unsigned long width;
+	// true for an enemy ball, false for a friendly ball
+	bool enemy;
+} ArduinoBall;
+
+/**
+ * Clears the queue and enables the interrupt on ARDUINO_SENS_OUT. Call from initialize().
+ */
+void arduinoInit();
+/**
+ * Takes the oldest classified ball from the queue. Only one task may call this.
+ *
+ * @param ball receives the ball
+ * @return true if a ball was dequeued, false if the queue was empty
+ */
+bool arduinoPoll(ArduinoBall *ball);
+/**
+ * Gets the number of balls dropped because the queue was full.
+ *
+ * @return the drop count since arduinoInit()
+ */
+unsigned long arduinoDropped();
+/**
+ * Pin-change interrupt handler for ARDUINO_SENS_OUT. Registered by arduinoInit(); exposed so a
+ * host build can fire synthetic edges after setting the level digitalRead() will report.
+ *
+ * @param pin the pin that changed
+ */
+void arduinoEdge(unsigned char pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
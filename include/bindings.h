@@ -0,0 +1,85 @@
+/** @file bindings.h
+ * @brief Table-driven mapping of button edges to mechanism events
+ *
+ * The operator controls for the mechanisms are a const table of Binding entries rather than a
+ * chain of if/else blocks. bindingsUpdate() scans the whole table once per cycle and posts the
+ * event of every row whose button was pressed or released that cycle to its mechanism's state
+ * machine (see mechanisms.h), in table order.
+ *
+ * Tables are const, so they stay in flash, and a driver's table can be swapped in with
+ * bindingsSelect().
+ */
+
+#ifndef BINDINGS_H_
+#define BINDINGS_H_
+
+#include <API.h>
+
+#include "buttons.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Button edges a binding fires on.
+ */
+#define BIND_PRESS 0
+#define BIND_RELEASE 1
+
+/**
+ * One row of a binding table. Use BIND() to fill it.
+ */
+typedef struct {
+	// INPUT_BUTTON() bit of the button
+	unsigned short button;
+	// BIND_PRESS or BIND_RELEASE
+	unsigned char edge;
+	// Machine id and event to post, e.g. MECH_SHOOTER and SHOOTER_START
+	unsigned char machine;
+	unsigned char event;
+} Binding;
+
+/**
+ * A complete set of bindings for one driver.
+ */
+typedef struct {
+	const Binding *entries;
+	unsigned char count;
+} BindingTable;
+
+/**
+ * Initializer for a Binding.
+ *
+ * @param group the button group, 5 to 8
+ * @param button one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ * @param edge BIND_PRESS or BIND_RELEASE
+ * @param machine the MECH_* machine id
+ * @param event the machine's event
+ */
+#define BIND(group, button, edge, machine, event) \
+	{ INPUT_BUTTON(group, button), edge, machine, event }
+/**
+ * Initializer for a BindingTable from an array of Binding.
+ */
+#define BINDING_TABLE(entries) { entries, sizeof(entries) / sizeof((entries)[0]) }
+
+/**
+ * Makes a table current. Call when a control mode starts or to switch drivers.
+ *
+ * @param table the table to use
+ */
+void bindingsSelect(const BindingTable *table);
+/**
+ * Posts the events of every binding whose button edge happened this cycle. Events carry
+ * micros() at the time of the call as their argument.
+ *
+ * @param buttons the buttons, already updated this cycle
+ */
+void bindingsUpdate(const Buttons *buttons);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
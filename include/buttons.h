@@ -0,0 +1,127 @@
+/** @file buttons.h
+ * @brief Debounced button edges computed from InputFrame bitmasks
+ *
+ * A Buttons tracker is updated once per cycle from an InputFrame. It keeps every button as one
+ * bit of a mask laid out like InputFrame.buttons (see INPUT_BUTTON()), and computes the
+ * pressed, released, held and toggled states of all buttons at once with bitwise operations.
+ *
+ * Debouncing uses a lockout per button: a change is accepted the cycle it is first seen, then
+ * further changes of that button are ignored until its debounce window has passed. A button
+ * still in a different state when its window ends changes then. This keeps presses responsive
+ * while filtering contact bounce and the radio dropping a button for one packet.
+ */
+
+#ifndef BUTTONS_H_
+#define BUTTONS_H_
+
+#include <API.h>
+
+#include "input.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of bits in a button mask; four per button group.
+ */
+#define BUTTONS_BITS 16
+/**
+ * Debounce window in milliseconds given to every button by buttonsInit().
+ */
+#define BUTTONS_DEBOUNCE_MS 20
+
+/**
+ * Debounced state of all buttons of one joystick. The masks use INPUT_BUTTON() bits.
+ */
+typedef struct {
+	// Buttons currently down after debouncing
+	unsigned short held;
+	// Buttons that went down or up in the last update
+	unsigned short pressed;
+	unsigned short released;
+	// Flips on every debounced press, for buttons that toggle a mechanism on and off
+	unsigned short toggled;
+	// Buttons inside their debounce window, whose changes are not accepted yet
+	unsigned short locked;
+	// Time each button last changed, and each button's debounce window, in milliseconds
+	unsigned long changeTime[BUTTONS_BITS];
+	unsigned short window[BUTTONS_BITS];
+} Buttons;
+
+/**
+ * Clears all button state and gives every button the default debounce window.
+ *
+ * @param buttons the tracker to initialize
+ */
+void buttonsInit(Buttons *buttons);
+/**
+ * Sets the debounce window of some buttons.
+ *
+ * @param buttons the tracker
+ * @param mask the buttons, as INPUT_BUTTON() bits
+ * @param windowMs the window in milliseconds; 0 disables debouncing for these buttons
+ */
+void buttonsSetDebounce(Buttons *buttons, unsigned short mask, unsigned short windowMs);
+/**
+ * Computes this cycle's edges from a new frame. Call exactly once per cycle.
+ *
+ * @param buttons the tracker
+ * @param frame the frame sampled this cycle
+ */
+void buttonsUpdate(Buttons *buttons, const InputFrame *frame);
+
+/**
+ * Gets whether a button is down.
+ *
+ * @param buttons the tracker
+ * @param group the button group, 5 to 8
+ * @param button one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ * @return true if the button is held after debouncing
+ */
+static inline bool buttonHeld(const Buttons *buttons, unsigned char group,
+	unsigned char button) {
+	return (buttons->held & INPUT_BUTTON(group, button)) != 0;
+}
+/**
+ * Gets whether a button went down in the last update.
+ *
+ * @param buttons the tracker
+ * @param group the button group, 5 to 8
+ * @param button one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ * @return true on the one cycle the button was pressed
+ */
+static inline bool buttonPressed(const Buttons *buttons, unsigned char group,
+	unsigned char button) {
+	return (buttons->pressed & INPUT_BUTTON(group, button)) != 0;
+}
+/**
+ * Gets whether a button went up in the last update.
+ *
+ * @param buttons the tracker
+ * @param group the button group, 5 to 8
+ * @param button one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ * @return true on the one cycle the button was released
+ */
+static inline bool buttonReleased(const Buttons *buttons, unsigned char group,
+	unsigned char button) {
+	return (buttons->released & INPUT_BUTTON(group, button)) != 0;
+}
+/**
+ * Gets the toggle state of a button.
+ *
+ * @param buttons the tracker
+ * @param group the button group, 5 to 8
+ * @param button one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ * @return true after an odd number of presses since buttonsInit()
+ */
+static inline bool buttonToggled(const Buttons *buttons, unsigned char group,
+	unsigned char button) {
+	return (buttons->toggled & INPUT_BUTTON(group, button)) != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
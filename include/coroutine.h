@@ -0,0 +1,136 @@
+/** @file coroutine.h
+ * @brief Stackless coroutines for running autonomous actions side by side
+ *
+ * A PROS task costs a stack of TASK_DEFAULT_STACK_SIZE words and there can only be TASK_MAX of
+ * them, so actions that run at the same time in autonomous (following the path, running the
+ * pickup, spinning up the shooter, waiting for the sorter) are coroutines in one task instead.
+ * Each is a function written between CO_BEGIN() and CO_END() that returns CO_WAITING wherever
+ * it waits; the next resume jumps straight back to that wait through a switch on the line
+ * number it saved. A coroutine's state is just that line and one timestamp, so it costs a few
+ * bytes rather than a stack.
+ *
+ * Being stackless has the usual limits: local variables do not survive a wait, so keep state
+ * in statics; only one wait may be written per line; and a wait cannot sit inside a switch
+ * statement of the coroutine's own.
+ *
+ * coroutinesRun() is the scheduler. Every COROUTINE_PERIOD_MS it samples the sensors, resumes
+ * each coroutine that has not finished once in order, and flushes the motors. The
+ * PROF_COROUTINES profiler section times the resumes with the bodies' own work included;
+ * tools/benchcoroutine.c measures what the scheduler itself adds per resume.
+ */
+
+#ifndef COROUTINE_H_
+#define COROUTINE_H_
+
+#include <API.h>
+
+#include "sensors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Period the scheduler resumes the coroutines at.
+ */
+#define COROUTINE_PERIOD_MS DRIVE_PERIOD_MS
+
+/**
+ * Results of resuming a coroutine.
+ */
+#define CO_WAITING 0
+#define CO_DONE 1
+
+// Saved line of a coroutine that has finished; never a real line number
+#define CO_FINISHED 0xFFFF
+
+struct Coroutine;
+
+/**
+ * A coroutine body.
+ *
+ * @param co the coroutine's state
+ * @param sens the sensors sampled this cycle
+ * @return CO_WAITING or CO_DONE
+ */
+typedef unsigned char (*CoroutineFunction)(struct Coroutine *co, const SensorFrame *sens);
+
+/**
+ * One coroutine: its body and where it is waiting.
+ */
+typedef struct Coroutine {
+	CoroutineFunction resume;
+	// Line of the wait to resume at, 0 before the first resume or CO_FINISHED
+	unsigned short line;
+	// millis() when CO_DELAY() ends
+	unsigned long time;
+} Coroutine;
+
+/**
+ * Scheduler statistics of the last coroutinesRun().
+ */
+typedef struct {
+	// Scheduler cycles, and coroutines resumed over all of them
+	unsigned long ticks;
+	unsigned long resumes;
+	// Most coroutines resumed in one cycle
+	unsigned long maxPerTick;
+} CoroutineStats;
+
+/**
+ * Starts a coroutine body. Must be followed by CO_END() at the end of the function.
+ */
+#define CO_BEGIN(co) switch ((co)->line) { case 0:
+/**
+ * Ends a coroutine body. Resuming a finished coroutine returns CO_DONE again.
+ */
+#define CO_END(co) } (co)->line = CO_FINISHED; return CO_DONE
+/**
+ * Waits until a condition holds. The condition is checked once per resume, immediately the
+ * first time.
+ */
+#define CO_WAIT_UNTIL(co, condition) do { \
+		(co)->line = __LINE__; case __LINE__: \
+		if (!(condition)) \
+			return CO_WAITING; \
+	} while (0)
+/**
+ * Waits while a condition holds, checking it once per resume.
+ */
+#define CO_WAIT_WHILE(co, condition) CO_WAIT_UNTIL(co, !(condition))
+/**
+ * Gives up the rest of this cycle and carries on at the next resume.
+ */
+#define CO_YIELD(co) do { \
+		(co)->line = __LINE__; \
+		return CO_WAITING; \
+		case __LINE__:; \
+	} while (0)
+/**
+ * Waits for a number of milliseconds.
+ */
+#define CO_DELAY(co, ms) do { \
+		(co)->time = millis() + (ms); \
+		CO_WAIT_UNTIL(co, (long)(millis() - (co)->time) >= 0); \
+	} while (0)
+
+/**
+ * Runs coroutines from their start until every one has finished. Each is resumed once per
+ * COROUTINE_PERIOD_MS, in array order, and the motors are flushed after each cycle.
+ *
+ * @param coroutines the coroutines, with resume set
+ * @param count the number of coroutines
+ */
+void coroutinesRun(Coroutine *coroutines, unsigned char count);
+/**
+ * Gets the scheduler statistics.
+ *
+ * @return a pointer to the statistics, reset by coroutinesRun()
+ */
+const CoroutineStats* coroutinesGetStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
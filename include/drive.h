@@ -0,0 +1,100 @@
+/** @file drive.h
+ * @brief Mecanum drive kinematics
+ *
+ * Mixes forward, strafe and turn commands into the four wheel powers. When the sum for any
+ * wheel exceeds the motor range, all four wheels are scaled down by the same factor so the
+ * ratios between them, and therefore the direction of travel, are preserved instead of being
+ * distorted by motorSet() clipping each wheel on its own. Integer math only.
+ *
+ * Each drive motor carries an integrated motor encoder. The IMEs are chained in wheel order,
+ * so a wheel's IME address is its DRIVE_* index.
+ */
+
+#ifndef DRIVE_H_
+#define DRIVE_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Wheel indices in the array filled by driveMix().
+ */
+#define DRIVE_FRONT_LEFT 0
+#define DRIVE_FRONT_RIGHT 1
+#define DRIVE_BACK_LEFT 2
+#define DRIVE_BACK_RIGHT 3
+#define DRIVE_WHEELS 4
+
+/**
+ * Mask of the drive motor ports for motorsFlushPorts().
+ */
+#define DRIVE_PORTS (MOTOR_PORT_MASK(M_FRONT_LEFT) | MOTOR_PORT_MASK(M_FRONT_RIGHT) | \
+	MOTOR_PORT_MASK(M_BACK_LEFT) | MOTOR_PORT_MASK(M_BACK_RIGHT))
+
+/**
+ * Largest power a wheel is given.
+ */
+#define DRIVE_MAX_POWER 127
+/**
+ * Slew limits of the drive motors in power units per second: full power is reached in about
+ * 250 ms and shed in about 125 ms, which spreads the current spike of a stick slam or a
+ * reversal without making the robot feel sluggish.
+ */
+#define DRIVE_SLEW_ACCEL 500
+#define DRIVE_SLEW_DECEL 1000
+
+/**
+ * IME ticks per second of a drive wheel at full power: 100 rpm at 627.2 ticks per turn for
+ * 393 motors in torque gearing.
+ */
+#define DRIVE_FREE_SPEED 1045
+
+/**
+ * Sets the slew limits of the drive motors and initializes their IMEs. Call once from
+ * initialize().
+ */
+void driveInit();
+/**
+ * Reads the IME of a drive wheel.
+ *
+ * @param wheel the wheel, one of the DRIVE_* indices
+ * @param ticks receives the wheel's count in IME ticks, positive for a positive motor power
+ * @return true if the IME answered
+ */
+bool driveGetPosition(unsigned char wheel, int *ticks);
+/**
+ * Computes desaturated mecanum wheel powers.
+ *
+ * @param forward the forward command from -127 to 127
+ * @param turn the turn command from -127 to 127
+ * @param strafe the sideways command from -127 to 127
+ * @param wheels receives the four wheel powers, each from -DRIVE_MAX_POWER to DRIVE_MAX_POWER
+ */
+void driveMix(int forward, int turn, int strafe, int wheels[DRIVE_WHEELS]);
+/**
+ * Mixes a drive command and sends it to the four drive motors through the output stage.
+ *
+ * @param forward the forward command from -127 to 127
+ * @param turn the turn command from -127 to 127
+ * @param strafe the sideways command from -127 to 127
+ */
+void driveMecanum(int forward, int turn, int strafe);
+/**
+ * Sends wheel powers straight to the four drive motors through the output stage.
+ *
+ * @param wheels the four wheel powers in DRIVE_* order; values outside -127 to 127 are clipped
+ */
+void driveWheels(const int wheels[DRIVE_WHEELS]);
+/**
+ * Stops the four drive motors.
+ */
+void driveStop();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,144 @@
+/** @file fsm.h
+ * @brief Table-driven finite state machines for the mechanisms
+ *
+ * Each mechanism is a state machine described by const tables: an FsmState per state with
+ * optional entry, run and exit actions and a timeout, and a list of FsmTransition rows. The
+ * runtime keeps up to FSM_MAX_MACHINES machines and one queue of events for all of them in
+ * static memory; nothing is allocated.
+ *
+ * Events are posted with fsmPost() and delivered by fsmRun(), which then calls the run action
+ * of every machine whose current state has one and delivers FSM_TIMEOUT to machines that have
+ * been in a state longer than its timeout. Machines in a state with neither do no work at all
+ * until an event arrives.
+ *
+ * All calls must come from the same task.
+ */
+
+#ifndef FSM_H_
+#define FSM_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of machines the runtime can hold.
+ */
+#define FSM_MAX_MACHINES 8
+/**
+ * Number of events that can wait for fsmRun(). Must be a power of two.
+ */
+#define FSM_QUEUE_SIZE 16
+/**
+ * Event delivered when a machine has spent its state's timeoutMs in that state. Machine
+ * events must not use this value.
+ */
+#define FSM_TIMEOUT 0
+/**
+ * Value of FsmTransition.from matching every state.
+ */
+#define FSM_ANY 0xFF
+/**
+ * Value of FsmTransition.to that runs the transition's action without leaving the state, so
+ * the exit and entry actions are not called.
+ */
+#define FSM_STAY 0xFF
+
+/**
+ * Action called on entering, running or leaving a state, or on a transition.
+ *
+ * @param arg the argument of the event that caused the call, or 0 for run actions, timeouts
+ * and the entry into the initial state
+ */
+typedef void (*FsmAction)(long arg);
+
+/**
+ * One state of a machine.
+ */
+typedef struct {
+	// Called when the state is entered, or NULL
+	FsmAction entry;
+	// Called on every fsmRun() while the machine is in this state, or NULL
+	FsmAction run;
+	// Called when the state is left, or NULL
+	FsmAction exit;
+	// Milliseconds after entry at which FSM_TIMEOUT is delivered, or 0 for none. A state with a
+	// timeout needs a transition on FSM_TIMEOUT, or it is delivered again every fsmRun()
+	unsigned short timeoutMs;
+} FsmState;
+
+/**
+ * One transition of a machine. The first row matching the current state and the event wins.
+ */
+typedef struct {
+	// State the transition leaves, or FSM_ANY
+	unsigned char from;
+	// Event that triggers it
+	unsigned char event;
+	// State to enter, or FSM_STAY
+	unsigned char to;
+	// Called between the exit and entry actions, or NULL
+	FsmAction action;
+} FsmTransition;
+
+/**
+ * The const description of a machine.
+ */
+typedef struct {
+	const FsmState *states;
+	const FsmTransition *transitions;
+	unsigned char transitionCount;
+	// State the machine starts in
+	unsigned char initial;
+} FsmMachine;
+
+/**
+ * Clears the event queue and stops every machine. Call when a control mode starts, before
+ * fsmStart().
+ */
+void fsmReset();
+/**
+ * Starts a machine in its initial state, calling that state's entry action.
+ *
+ * @param id the machine slot, 0 to FSM_MAX_MACHINES - 1
+ * @param machine the machine's tables
+ */
+void fsmStart(unsigned char id, const FsmMachine *machine);
+/**
+ * Queues an event for a machine.
+ *
+ * @param id the machine slot
+ * @param event the event, anything but FSM_TIMEOUT
+ * @param arg an argument passed to the actions the event triggers
+ * @return true if the event was queued, false if the queue was full and it was dropped
+ */
+bool fsmPost(unsigned char id, unsigned char event, long arg);
+/**
+ * Delivers the queued events, then runs the active states and checks their timeouts. An event
+ * posted by an entry, exit or transition action while the queue is being delivered is delivered
+ * in the same call, unless FSM_QUEUE_SIZE events have already been. Events posted by run actions,
+ * or by the actions of a timeout transition, come after the queue is delivered and wait for the
+ * next call.
+ */
+void fsmRun();
+/**
+ * Gets the current state of a machine.
+ *
+ * @param id the machine slot
+ * @return the state index
+ */
+unsigned char fsmState(unsigned char id);
+/**
+ * Gets the number of events dropped because the queue was full.
+ *
+ * @return the count since the last fsmReset()
+ */
+unsigned long fsmDropped();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/** @file input.h
+ * @brief Per-cycle snapshot of the VEX Joystick
+ *
+ * The joystick is sampled once at the top of each control cycle into an InputFrame, and every
+ * mechanism reads its buttons and axes from that frame. This keeps the number of joystick API
+ * calls per cycle fixed and guarantees all mechanisms see the same input for a given cycle.
+ */
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of analog axes on a VEX Joystick.
+ */
+#define INPUT_AXES 4
+/**
+ * Joystick analog axis numbers as used by joystickGetAnalog().
+ */
+#define AXIS_RIGHT_X 1
+#define AXIS_RIGHT_Y 2
+#define AXIS_LEFT_Y 3
+#define AXIS_LEFT_X 4
+
+/**
+ * Bit for a button in InputFrame.buttons. Each button group (5-8) owns one nibble and the
+ * JOY_* constants are used directly as the bit within the nibble, so groups 5 and 6 use only
+ * their JOY_DOWN and JOY_UP bits.
+ *
+ * @param group the button group, 5 to 8
+ * @param button one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ */
+#define INPUT_BUTTON(group, button) ((unsigned short)((button) << (((group) - 5) * 4)))
+
+/**
+ * Snapshot of one joystick taken at the start of a control cycle.
+ */
+typedef struct {
+	// millis() when the frame was sampled
+	unsigned long time;
+	// Axis values from -127 to 127; axis[0] holds axis 1
+	signed char axis[INPUT_AXES];
+	// Pressed buttons as INPUT_BUTTON() bits
+	unsigned short buttons;
+} InputFrame;
+
+/**
+ * Reads all axes and buttons of a joystick into a frame, or takes them from the input source
+ * if one is set.
+ *
+ * @param frame the frame to fill
+ * @param joystick the joystick slot to read, 1 or 2
+ */
+void inputSample(InputFrame *frame, unsigned char joystick);
+/**
+ * Replaces the joystick with another source of frames, such as a recording being replayed.
+ * inputSample() still stamps the time.
+ *
+ * @param source fills in the axes and buttons of a frame, or NULL to read the joystick
+ */
+void inputSetSource(void (*source)(InputFrame *frame));
+
+/**
+ * Gets an axis value from a frame.
+ *
+ * @param frame the sampled frame
+ * @param axis the axis number, 1 to 4, as passed to joystickGetAnalog()
+ * @return the axis value from -127 to 127
+ */
+static inline int inputAnalog(const InputFrame *frame, unsigned char axis) {
+	return frame->axis[axis - 1];
+}
+
+/**
+ * Gets a button state from a frame.
+ *
+ * @param frame the sampled frame
+ * @param group the button group, 5 to 8
+ * @param button one of JOY_UP, JOY_DOWN, JOY_LEFT or JOY_RIGHT
+ * @return true if the button was pressed when the frame was sampled
+ */
+static inline bool inputDigital(const InputFrame *frame, unsigned char group,
+	unsigned char button) {
+	return (frame->buttons & INPUT_BUTTON(group, button)) != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,87 @@
+/** @file lifter.h
+ * @brief Lifter with interrupt-driven end stops
+ *
+ * The limit switches at the top (LIFTER_SENS_MAX) and bottom (LIFTER_SENS_MIN) of the lifter's
+ * travel read LOW when pressed. Instead of being polled once per control cycle, both pins
+ * raise an interrupt on every edge. A closing (falling) edge latches the switch and, if the
+ * lifter is being driven into it, stops the motor from the handler with motorsHalt(), so the
+ * motor no longer runs on for up to a full cycle. An opening (rising) edge clears the latch.
+ *
+ * The control loop drives the lifter only through lifterDrive(), which refuses to drive into
+ * a latched end stop.
+ */
+
+#ifndef LIFTER_H_
+#define LIFTER_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * End stop statistics since lifterInit(). Times are in microseconds.
+ */
+typedef struct {
+	// Number of times an end stop interrupt stopped the motor
+	unsigned long cutoffs;
+	// Time from entering the interrupt handler to the motor being stopped
+	unsigned long lastStopLatency;
+	unsigned long maxStopLatency;
+	// Time from a cutoff to the control loop next running, i.e. how much longer a polled end
+	// stop would have left the motor running
+	unsigned long lastPollDelay;
+	unsigned long maxPollDelay;
+} LifterStats;
+
+/**
+ * Reads the initial state of both end stops and attaches their interrupt handler. Call once
+ * from initialize().
+ */
+void lifterInit();
+/**
+ * Commands the lifter motor, unless the power would drive it into a closed end stop, in which
+ * case it is stopped instead. Call once per control cycle.
+ *
+ * @param power the signed motor power from -127 (down) to 127 (up)
+ */
+void lifterDrive(int power);
+/**
+ * Limits a lifter power so it does not drive into a closed end stop.
+ *
+ * @param power the signed motor power from -127 (down) to 127 (up)
+ * @return power, or 0 if it would drive into a closed end stop
+ */
+int lifterLimit(int power);
+/**
+ * Gets whether the lifter is at the top of its travel.
+ *
+ * @return true if LIFTER_SENS_MAX is closed
+ */
+bool lifterAtMax();
+/**
+ * Gets whether the lifter is at the bottom of its travel.
+ *
+ * @return true if LIFTER_SENS_MIN is closed
+ */
+bool lifterAtMin();
+/**
+ * Gets the end stop statistics.
+ *
+ * @return a pointer to the statistics, valid until the next lifterInit()
+ */
+const LifterStats* lifterGetStats();
+/**
+ * Interrupt handler for both end stop pins. Public only so it can be registered with
+ * ioSetInterrupt(); do not call it directly.
+ *
+ * @param pin the pin that changed
+ */
+void lifterEdge(unsigned char pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+/** @file looptimer.h
+ * @brief Fixed-rate loop scheduling with per-cycle timing statistics
+ *
+ * A LoopTimer drives a control loop off an absolute wake time (taskDelayUntil()) instead of a
+ * relative delay(), so the loop period does not stretch by however long the loop body took.
+ * Every cycle it measures the real period and the execution time with micros() and counts
+ * cycles whose work did not fit in the period.
+ *
+ * Only millis(), micros() and taskDelayUntil() are used, so the module can be built on a host
+ * with those three functions stubbed, as test/looptimer.c does.
+ */
+
+#ifndef LOOPTIMER_H_
+#define LOOPTIMER_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Timing state and statistics for one periodic loop. All durations are in microseconds except
+ * periodMs and wakeTime, which are in the millisecond units used by taskDelayUntil().
+ */
+typedef struct {
+	// Nominal loop period in milliseconds
+	unsigned long periodMs;
+	// Absolute time (millis()) the loop last woke up at, advanced by periodMs every cycle
+	unsigned long wakeTime;
+	// micros() at the start of the current cycle
+	unsigned long cycleStart;
+	// Measured time between the two most recent cycle starts
+	unsigned long lastPeriod;
+	unsigned long minPeriod;
+	unsigned long maxPeriod;
+	// Measured time spent between loopTimerBegin() and loopTimerWait() in the last cycle
+	unsigned long lastExec;
+	unsigned long maxExec;
+	// Sum of all execution times, used for the mean and CPU share
+	unsigned long long totalExec;
+	// Number of completed cycles
+	unsigned long cycles;
+	// Number of cycles whose work ran past the next wake time
+	unsigned long overruns;
+} LoopTimer;
+
+/**
+ * Initializes a loop timer and anchors its schedule to the current time.
+ *
+ * @param timer the timer to initialize
+ * @param periodMs the loop period in milliseconds
+ */
+void loopTimerInit(LoopTimer *timer, unsigned long periodMs);
+/**
+ * Marks the start of the work for one cycle. Call this first thing in the loop body.
+ *
+ * @param timer the loop timer
+ */
+void loopTimerBegin(LoopTimer *timer);
+/**
+ * Marks the end of the work for one cycle and blocks until the next absolute wake time.
+ *
+ * If the work overran the period, the overrun is counted and the schedule skips the missed
+ * slots rather than running several cycles back to back to catch up.
+ *
+ * @param timer the loop timer
+ */
+void loopTimerWait(LoopTimer *timer);
+/**
+ * Clears the accumulated statistics without disturbing the schedule.
+ *
+ * @param timer the loop timer
+ */
+void loopTimerResetStats(LoopTimer *timer);
+/**
+ * Gets the peak-to-peak period jitter seen since the statistics were last reset.
+ *
+ * @param timer the loop timer
+ * @return maxPeriod - minPeriod in microseconds, or 0 before two periods have been measured
+ */
+unsigned long loopTimerJitter(const LoopTimer *timer);
+/**
+ * Gets the mean execution time per cycle.
+ *
+ * @param timer the loop timer
+ * @return the mean execution time in microseconds, or 0 before the first cycle completes
+ */
+unsigned long loopTimerMeanExec(const LoopTimer *timer);
+/**
+ * Gets the share of the CPU the loop uses, i.e. its mean execution time over its period.
+ *
+ * @param timer the loop timer
+ * @return the CPU share in tenths of a percent
+ */
+unsigned long loopTimerCpuShare(const LoopTimer *timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
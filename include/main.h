@@ -27,6 +27,28 @@
 
 #include <API.h>
 
+#include "arduino.h"
+#include "bindings.h"
+#include "buttons.h"
+#include "coroutine.h"
+#include "drive.h"
+#include "fsm.h"
+#include "input.h"
+#include "lifter.h"
+#include "looptimer.h"
+#include "mechanisms.h"
+#include "motors.h"
+#include "power.h"
+#include "prof.h"
+#include "recorder.h"
+#include "sensors.h"
+#include "shaping.h"
+#include "sorter.h"
+#include "telemetry.h"
+#include "trajectory.h"
+#include "trapezoid.h"
+#include "vm.h"
+
 // Allow usage of this file in C++ programs
 #ifdef __cplusplus
 extern "C" {
@@ -95,9 +117,41 @@ void initialize();
 void operatorControl();
 
 
+// Motor ports
+#define M_FRONT_LEFT 2
+#define M_FRONT_RIGHT 3
+#define M_BACK_LEFT 4
+#define M_BACK_RIGHT 5
+#define PICKUP 1
+#define SHOOTER 7
+#define RAMP 8
+#define SORTER 9
+#define LIFTER 6
+#define MIXER 10
+
+// Sensor (digital) ports
+#define LIFTER_SENS_MAX 3
+#define LIFTER_SENS_MIN 4
+#define ARDUINO_SENS_OUT 7
+
 #define QUAD_TOP_PORT 1
 #define QUAD_BOTTOM_PORT 2
-Encoder sorter;
+extern Encoder sorter;
+
+/**
+ * Operator control runs as two periodic tasks: the drive (operatorControl() itself) and the
+ * mechanisms. Telemetry runs in a third task at TELEMETRY_PERIOD_MS.
+ */
+#define DRIVE_PERIOD_MS 10
+#define DRIVE_PRIORITY (TASK_PRIORITY_DEFAULT + 2)
+#define MECHANISM_PERIOD_MS 20
+#define MECHANISM_PRIORITY TASK_PRIORITY_DEFAULT
+/**
+ * Timing statistics for the drive, mechanism and telemetry tasks.
+ */
+extern LoopTimer driveTimer;
+extern LoopTimer mechanismTimer;
+extern LoopTimer telemetryTimer;
 
 // End C++ export structure
 #ifdef __cplusplus
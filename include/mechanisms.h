@@ -0,0 +1,90 @@
+/** @file mechanisms.h
+ * @brief State machines for the pickup, shooter, ramp, lifter, sorter and mixer
+ *
+ * Every mechanism runs as a machine in the fsm.h runtime. The operator's buttons (through the
+ * binding table) and the Arduino post MECH_* events, and the machines command their motors
+ * from entry actions, so a mechanism that is simply on or off costs nothing between events.
+ * Only the lifter while moving and the sorter, which holds its paddle with feedback, have run
+ * actions.
+ */
+
+#ifndef MECHANISMS_H_
+#define MECHANISMS_H_
+
+#include <API.h>
+
+#include "sensors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Machine ids, used as the fsm.h slot of each mechanism.
+ */
+#define MECH_PICKUP 0
+#define MECH_SHOOTER 1
+#define MECH_RAMP 2
+#define MECH_LIFTER 3
+#define MECH_SORTER 4
+#define MECH_MIXER 5
+
+/**
+ * Events of each machine. Event 0 is FSM_TIMEOUT.
+ */
+// Pickup: toggle on or off, or run while a button is held; it runs while toggled on or held
+#define PICKUP_TOGGLE 1
+#define PICKUP_HOLD 2
+#define PICKUP_RELEASE 3
+// Shooter: spin up or stop
+#define SHOOTER_START 1
+#define SHOOTER_STOP 2
+// Ramp: run up or down while a button is held, up while both are; each button has its own
+// release so the ramp can go on with the one still held
+#define RAMP_UP 1
+#define RAMP_DOWN 2
+#define RAMP_UP_RELEASE 3
+#define RAMP_DOWN_RELEASE 4
+// Lifter: raise or lower while a button is held, raise while both are, as the ramp;
+// LIFTER_END_STOP is posted by the lifter itself when it reaches the end of its travel
+#define LIFTER_RAISE 1
+#define LIFTER_LOWER 2
+#define LIFTER_RAISE_RELEASE 3
+#define LIFTER_LOWER_RELEASE 4
+#define LIFTER_END_STOP 5
+// Sorter: a classified ball, with the micros() it was classified at as the argument;
+// SORTER_DONE is posted by the sorter itself when its queue empties
+#define SORTER_FRIENDLY 1
+#define SORTER_ENEMY 2
+#define SORTER_DONE 3
+// Mixer: run backwards while a button is held, forwards otherwise
+#define MIXER_REVERSE 1
+#define MIXER_FORWARD 2
+
+/**
+ * Mechanism speeds in 127ths of top speed. These give the same speeds the raw values 127, 80,
+ * 65, 127 and 30 gave before the motor stage linearized its outputs.
+ */
+#define PICKUP_POWER 127
+#define SHOOTER_POWER 107
+#define RAMP_POWER 94
+#define LIFTER_POWER 127
+#define MIXER_POWER 41
+
+/**
+ * Resets the state machine runtime and starts every mechanism in its idle state. Call when
+ * operator control starts, after motorsInit() and sorterInit().
+ */
+void mechanismsStart();
+/**
+ * Delivers this cycle's events and runs the active mechanisms.
+ *
+ * @param sens the sensor frame for this cycle
+ */
+void mechanismsUpdate(const SensorFrame *sens);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,165 @@
+/** @file motors.h
+ * @brief Shadow-register motor output stage
+ *
+ * Control code records the value it wants on each motor port with motorsCommand() during a
+ * cycle, and motorsFlush() at the end of the cycle writes only the ports whose value differs
+ * from what was last written. This gives each cycle a single commit point for outputs and
+ * skips the redundant motorSet() calls a mechanism would otherwise make every pass.
+ *
+ * A port can also be given slew rate limits with motorsSetSlew(). The flush then moves the
+ * port's output towards its commanded value by at most the allowed change for the time since
+ * the port was last flushed, so a step command becomes a ramp and the motor's current spike
+ * is spread out. Separate rates apply when the output grows in magnitude (accelerating) and
+ * when it shrinks towards zero (decelerating).
+ *
+ * Commanded values are speeds, as a fraction of top speed in 127ths. A 393 motor's speed is far
+ * from proportional to its motorSet() value (nothing moves below about 12, and most of the
+ * speed is reached by 80), so every write goes through motorLinearTable to the value that gives
+ * the commanded speed. Statistics and telemetry report the commanded speed, not the raw value.
+ *
+ * Several tasks may share the stage as long as each one commands and flushes its own ports:
+ * motorsCommand() only touches per-port state, and flushes are serialized by a mutex. A flush
+ * that cannot take the mutex within MOTOR_LOCK_TIMEOUT_MS is skipped rather than blocking its
+ * task, so the stage keeps running if a task holding it is deleted.
+ */
+
+#ifndef MOTORS_H_
+#define MOTORS_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of motor ports on the VEX Cortex (1-10).
+ */
+#define MOTOR_PORTS 10
+/**
+ * Bit for a motor port (1-10) in the port masks taken by motorsFlushPorts().
+ */
+#define MOTOR_PORT_MASK(port) (1 << ((port) - 1))
+/**
+ * Mask covering every motor port.
+ */
+#define MOTOR_ALL_PORTS ((1 << MOTOR_PORTS) - 1)
+/**
+ * Longest a flush or motorsSuspend() waits for the flush mutex. A flush holds it for well under
+ * a millisecond, so only a motorsSuspend() or a task deleted while flushing keeps it longer.
+ */
+#define MOTOR_LOCK_TIMEOUT_MS 5
+
+/**
+ * The motorSet() value that turns a motor at k/127 of its top speed, for k from 0 to 127;
+ * negative speeds use the negated entry. Generated into src/motorlut.c by tools/mklut.c from
+ * the measurements in tools/motor393.csv.
+ */
+extern const unsigned char motorLinearTable[128];
+
+/**
+ * Output stage statistics since the last motorsInit().
+ */
+typedef struct {
+	// Number of flushes performed
+	unsigned long flushes;
+	// Number of motorSet() calls actually made
+	unsigned long writes;
+	// Number of commands that matched the value already on the port and were not written
+	unsigned long writesAvoided;
+	// Number of motorsHalt() calls
+	unsigned long halts;
+	// Number of writes that the slew limiter held short of the commanded value
+	unsigned long slewLimited;
+	// Number of writes scaled down by motorsSetScale()
+	unsigned long powerLimited;
+	// Number of flushes skipped because the flush mutex stayed taken for MOTOR_LOCK_TIMEOUT_MS
+	unsigned long lockTimeouts;
+} MotorStats;
+
+/**
+ * Resets every commanded value to 0, clears the statistics, and forces every port to be
+ * written on the next flush. Call this when a control mode starts, since the kernel stops the
+ * motors behind our back whenever the robot is disabled.
+ */
+void motorsInit();
+/**
+ * Sets the slew rate limits of a port. The limits persist across motorsInit().
+ *
+ * @param port the motor port, 1 to 10
+ * @param accel the largest increase in output magnitude per second, or 0 for no limit
+ * @param decel the largest decrease in output magnitude per second, or 0 for no limit
+ */
+void motorsSetSlew(unsigned char port, unsigned int accel, unsigned int decel);
+/**
+ * Sets the percentage of its commanded value a port is driven at, so the power manager can
+ * shave outputs without the control code knowing. The scale persists across motorsInit().
+ *
+ * @param port the motor port, 1 to 10
+ * @param percent the scale from 0 to 100
+ */
+void motorsSetScale(unsigned char port, unsigned char percent);
+/**
+ * Sets the value a motor port should be driven at after the next flush.
+ *
+ * @param port the motor port, 1 to 10
+ * @param speed the new signed speed; values outside -127 to 127 are clipped
+ */
+void motorsCommand(unsigned char port, int speed);
+/**
+ * Equivalent to motorsCommand(port, 0).
+ *
+ * @param port the motor port, 1 to 10
+ */
+void motorsStop(unsigned char port);
+/**
+ * Stops a port at once, bypassing the flush and its slew limits, and sets its commanded value
+ * to 0. Unlike the rest of the stage this is safe to call from an interrupt handler, so a
+ * limit switch can cut a motor without waiting for the control loop.
+ *
+ * @param port the motor port, 1 to 10
+ */
+void motorsHalt(unsigned char port);
+/**
+ * Gets the value last commanded for a port, whether or not it has been flushed yet.
+ *
+ * @param port the motor port, 1 to 10
+ * @return the commanded speed from -127 to 127
+ */
+int motorsGetCommand(unsigned char port);
+/**
+ * Writes every port whose commanded value differs from the value last written, subject to
+ * the output scales and slew limits.
+ */
+void motorsFlush();
+/**
+ * Writes the ports in a mask whose commanded value differs from the value last written. A
+ * task that owns only some of the motors flushes just those, so it never commits a value
+ * another task is halfway through computing.
+ *
+ * @param ports a mask of MOTOR_PORT_MASK() bits
+ */
+void motorsFlushPorts(unsigned short ports);
+/**
+ * Stops every motor and holds them stopped, keeping their commanded values, until
+ * motorsResume(). Flushes from other tasks are skipped in the meantime. For work such as flash
+ * writes that PROS only allows with the actuators stopped.
+ */
+void motorsSuspend();
+/**
+ * Ends a motorsSuspend(). The next flush of each port writes its commanded value again, subject
+ * to the slew limits.
+ */
+void motorsResume();
+/**
+ * Gets the output stage statistics.
+ *
+ * @return a pointer to the statistics, valid until the next motorsInit()
+ */
+const MotorStats* motorsGetStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,14 @@
+/** @file paths.h
+ * @brief Autonomous drive trajectories
+ *
+ * Generated by tools/mktraj.c from tools/paths.txt; do not edit.
+ */
+
+#ifndef PATHS_H_
+#define PATHS_H_
+
+#include "trajectory.h"
+
+extern const Trajectory autoPath;
+
+#endif
@@ -0,0 +1,89 @@
+/** @file power.h
+ * @brief Battery-aware motor current budget
+ *
+ * The power manager samples the main and backup battery voltages and estimates the current
+ * the ten motors will draw from their commanded outputs. Once the main battery sags below
+ * POWER_SAG_MV and the estimate exceeds a budget that shrinks as it sags further, it shaves
+ * the lowest-priority mechanisms first (the mixer and ramp, then the shooter and pickup, then
+ * the lifter and sorter) and the drive last, by setting per-port output scales that
+ * motorsFlushPorts() applies. This keeps peak load below the level that browns out the Cortex
+ * and resets the robot mid-match.
+ *
+ * The current model is deliberately simple: a motor is assumed to draw POWER_FULL_LOAD_MA at
+ * full command and nominal voltage, in proportion to its command and the battery voltage. It
+ * ignores back-EMF, so it overestimates the draw of motors already at speed; a healthy battery
+ * carries that load, which is why nothing is shaved above POWER_SAG_MV.
+ */
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Estimated current of one loaded motor at full command and POWER_NOMINAL_MV, in mA.
+ */
+#define POWER_FULL_LOAD_MA 2500
+/**
+ * Main battery voltage the estimate is scaled from, in mV.
+ */
+#define POWER_NOMINAL_MV 7200
+/**
+ * Current budget as the main battery reaches POWER_SAG_MV, in mA. Above it nothing is shaved;
+ * below it the budget falls linearly to POWER_FLOOR_MA at POWER_LOW_MV.
+ */
+#define POWER_BUDGET_MA 14000
+#define POWER_FLOOR_MA 7000
+#define POWER_SAG_MV 7200
+#define POWER_LOW_MV 6400
+/**
+ * With the backup battery below this voltage (or missing) a brownout would reset the Cortex,
+ * so the budget is cut to 3/4.
+ */
+#define POWER_BACKUP_LOW_MV 7000
+/**
+ * Number of priority levels; level 0 is shaved last.
+ */
+#define POWER_LEVELS 4
+
+/**
+ * Power manager state and statistics since powerInit(). Voltages are filtered.
+ */
+typedef struct {
+	unsigned int mainMv;
+	unsigned int backupMv;
+	unsigned int minMainMv;
+	// Estimated draw of the current commands and the budget it was held to, in mA
+	unsigned long demandMa;
+	unsigned long budgetMa;
+	unsigned long peakDemandMa;
+	// Number of updates that had to shave outputs
+	unsigned long shavedUpdates;
+} PowerStats;
+
+/**
+ * Resets the statistics and voltage filters and removes any shaving. Call when a control mode
+ * starts, after motorsInit().
+ */
+void powerInit();
+/**
+ * Samples the batteries, estimates the draw of every port's current command and sets the
+ * output scales for the next flushes. Call once per control cycle, before flushing.
+ */
+void powerUpdate();
+/**
+ * Gets the power manager statistics.
+ *
+ * @return a pointer to the statistics, valid until the next powerInit()
+ */
+const PowerStats* powerGetStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
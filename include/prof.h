@@ -0,0 +1,119 @@
+/** @file prof.h
+ * @brief Per-section loop profiler
+ *
+ * PROF_BEGIN() and PROF_END() bracket a block of control code and record how long it took with
+ * micros(). Every section keeps its count, min, max and mean and a histogram of power-of-two
+ * buckets, all in static memory. Sending 'p' to the robot's stdin makes the telemetry task
+ * dump the statistics as TELEM_PROFILE records, and 'r' clears them.
+ *
+ * The profiler is only built when PROF_ENABLED is defined to 1 (make PROFILE=1). Otherwise the
+ * macros expand to nothing and the functions to no-ops, so the probes can stay in the code.
+ *
+ * Each section must only be timed from one task. A dump taken while a section is being
+ * recorded may mix one sample into some fields and not others.
+ */
+
+#ifndef PROF_H_
+#define PROF_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef PROF_ENABLED
+#define PROF_ENABLED 0
+#endif
+/**
+ * Clock the probes read, in microseconds. The host simulation substitutes one that advances
+ * while code runs.
+ */
+#ifndef PROF_CLOCK
+#define PROF_CLOCK micros
+#endif
+
+/**
+ * Profiled sections. Keep below 16 so the section fits in a TELEM_PROFILE channel.
+ */
+#define PROF_DRIVE 0
+#define PROF_BINDINGS 1
+#define PROF_MECHANISMS 2
+#define PROF_TELEMETRY 3
+#define PROF_VM 4
+#define PROF_COROUTINES 5
+#define PROF_SECTIONS 6
+
+/**
+ * Number of histogram buckets. Bucket 0 counts samples under 2 us, bucket k samples from 2^k
+ * to 2^(k+1) - 1 us, and the last bucket everything longer.
+ */
+#define PROF_BUCKETS 12
+
+/**
+ * Statistics for one section. Times are in microseconds.
+ */
+typedef struct {
+	unsigned long count;
+	unsigned long min;
+	unsigned long max;
+	unsigned long long total;
+	unsigned long buckets[PROF_BUCKETS];
+} ProfSection;
+
+#if PROF_ENABLED
+
+/**
+ * Starts timing a section. Must be paired with PROF_END() for the same section in the same
+ * block.
+ *
+ * @param section one of the PROF_* sections
+ */
+#define PROF_BEGIN(section) unsigned long profStart##section = PROF_CLOCK()
+/**
+ * Stops timing a section and records the sample.
+ *
+ * @param section one of the PROF_* sections
+ */
+#define PROF_END(section) profRecord(section, PROF_CLOCK() - profStart##section)
+
+unsigned long PROF_CLOCK();
+/**
+ * Records one sample for a section.
+ *
+ * @param section one of the PROF_* sections
+ * @param micros the time the section took in microseconds
+ */
+void profRecord(unsigned char section, unsigned long micros);
+/**
+ * Clears the statistics of every section.
+ */
+void profReset();
+/**
+ * Gets the statistics of a section.
+ *
+ * @param section one of the PROF_* sections
+ * @return a pointer to the statistics, or NULL if the section is out of range
+ */
+const ProfSection* profGet(unsigned char section);
+/**
+ * Pushes the statistics of every section that has samples as TELEM_PROFILE records.
+ */
+void profDump();
+
+#else
+
+#define PROF_BEGIN(section)
+#define PROF_END(section)
+#define profRecord(section, micros) ((void)0)
+#define profReset() ((void)0)
+#define profGet(section) ((const ProfSection*)NULL)
+#define profDump() ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/** @file recorder.h
+ * @brief Driver input recording and replay
+ *
+ * The recorder captures the joystick frame of every drive cycle for RECORDER_DURATION_MS so a
+ * routine driven by hand can be replayed as the autonomous. Frames are delta-compressed into a
+ * fixed RAM buffer: each frame stores only the fields that changed since the previous one, and
+ * runs of unchanged frames collapse into a single byte. No frame takes more than
+ * RECORDER_MAX_FRAME_BYTES, so the buffer always holds a full recording and memory use never
+ * exceeds RECORDER_MAX_FRAME_BYTES per drive cycle.
+ *
+ * That bound is paid up front: the buffer is a static RECORDER_BUFFER_SIZE bytes, 10.5 KB of
+ * the Cortex's 64 KB of RAM, whether or not anything is ever recorded, although typical
+ * driving encodes to a few hundred bytes. Shortening RECORDER_DURATION_MS or lengthening
+ * RECORDER_PERIOD_MS is the way to get RAM back.
+ *
+ * A finished recording is written to a flash file with fopen()/fwrite(). PROS requires the
+ * actuators to be stopped while the file system writes, so the caller saves only once the robot
+ * stands still. For replay, recorderReplay() is installed as the input source with
+ * inputSetSource() and hands out one recorded frame per drive cycle; after the last frame it
+ * returns a centred, released joystick.
+ */
+
+#ifndef RECORDER_H_
+#define RECORDER_H_
+
+#include <API.h>
+
+#include "input.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Length of a recording, the same as the autonomous period.
+ */
+#define RECORDER_DURATION_MS 15000
+/**
+ * Period the frames are recorded and replayed at.
+ */
+#define RECORDER_PERIOD_MS DRIVE_PERIOD_MS
+/**
+ * Largest encoding of a frame: a header byte, every axis and both button bytes.
+ */
+#define RECORDER_MAX_FRAME_BYTES (1 + INPUT_AXES + 2)
+/**
+ * Size of the recording buffer: enough for a full recording of frames that all change.
+ */
+#define RECORDER_BUFFER_SIZE (RECORDER_DURATION_MS / RECORDER_PERIOD_MS * \
+	RECORDER_MAX_FRAME_BYTES)
+/**
+ * Flash file the recording is kept in.
+ */
+#define RECORDER_FILE "auton"
+
+/**
+ * Recorder states.
+ */
+#define RECORDER_IDLE 0
+#define RECORDER_RECORDING 1
+// Recorded but not yet saved
+#define RECORDER_FINISHED 2
+#define RECORDER_REPLAYING 3
+
+/**
+ * Recording and replay statistics.
+ */
+typedef struct {
+	// Frames and encoded bytes in the recording
+	unsigned long frames;
+	unsigned long bytes;
+	// Frames repeated to fill drive cycles that were skipped while recording
+	unsigned long gaps;
+	// Frames replayed so far
+	unsigned long replayed;
+	// Largest difference between when a frame was replayed and when it was due, in
+	// microseconds
+	unsigned long maxReplayError;
+} RecorderStats;
+
+/**
+ * Discards any recording and starts a new one with the next frame added.
+ */
+void recorderStart();
+/**
+ * Appends a frame to the recording in progress, if any. The recording finishes once it spans
+ * RECORDER_DURATION_MS.
+ *
+ * @param frame the frame sampled this drive cycle
+ */
+void recorderAdd(const InputFrame *frame);
+/**
+ * Writes a finished recording to a flash file. Only call this with every motor stopped.
+ *
+ * @param file the flash file name
+ * @return true if the recording was written
+ */
+bool recorderSave(const char *file);
+/**
+ * Reads a recording from a flash file and prepares to replay it from the start.
+ *
+ * @param file the flash file name
+ * @return true if a valid recording was read
+ */
+bool recorderLoad(const char *file);
+/**
+ * Input source for inputSetSource() that replays the loaded recording, one frame per call.
+ *
+ * @param frame receives the next recorded axes and buttons
+ */
+void recorderReplay(InputFrame *frame);
+/**
+ * Gets the recorder state.
+ *
+ * @return one of the RECORDER_* states
+ */
+unsigned char recorderState();
+/**
+ * Gets the recording and replay statistics.
+ *
+ * @return a pointer to the statistics
+ */
+const RecorderStats* recorderGetStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+/** @file sensors.h
+ * @brief Per-cycle snapshot of the robot sensors
+ *
+ * Every encoder, digital pin and analog channel is sampled once per control cycle into a
+ * timestamped SensorFrame. Control code reads only from the frame, so a decision that looks
+ * at the same sensor twice (e.g. the sorter's <= 90 / > 90 test) always sees one value.
+ */
+
+#ifndef SENSORS_H_
+#define SENSORS_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of digital pins sampled (1-12).
+ */
+#define SENSOR_DIGITAL_PINS 12
+/**
+ * Number of analog channels sampled (1-8).
+ */
+#define SENSOR_ANALOG_CHANNELS BOARD_NR_ADC_PINS
+
+/**
+ * Snapshot of all sensors taken at the start of a control cycle.
+ */
+typedef struct {
+	// micros() when the frame was sampled
+	unsigned long time;
+	// Sorter quadrature encoder count
+	int sorterCount;
+	// Digital pin levels; bit (pin - 1) is set when the pin read HIGH
+	unsigned short digital;
+	// Raw analog readings; analog[0] holds channel 1
+	short analog[SENSOR_ANALOG_CHANNELS];
+} SensorFrame;
+
+/**
+ * Reads every encoder, digital pin and analog channel into a frame.
+ *
+ * @param frame the frame to fill
+ */
+void sensorsSample(SensorFrame *frame);
+
+/**
+ * Gets a digital pin level from a frame.
+ *
+ * @param frame the sampled frame
+ * @param pin the digital pin, 1 to 12
+ * @return HIGH or LOW as digitalRead() would have returned
+ */
+static inline bool sensorDigital(const SensorFrame *frame, unsigned char pin) {
+	return (frame->digital >> (pin - 1)) & 1;
+}
+
+/**
+ * Gets an analog reading from a frame.
+ *
+ * @param frame the sampled frame
+ * @param channel the analog channel, 1 to 8
+ * @return the raw reading from 0 to 4095
+ */
+static inline int sensorAnalog(const SensorFrame *frame, unsigned char channel) {
+	return frame->analog[channel - 1];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+/** @file shaping.h
+ * @brief Joystick response shaping
+ *
+ * Each stick gets a radial deadzone: the stick is centred while its distance from the centre is
+ * within the deadzone, and beyond it the distance is rescaled so it grows from 0 at the edge of
+ * the deadzone to 127 at full throw. Unlike a deadzone on each axis, this does not snap a
+ * diagonal push onto an axis or make the robot lurch when the stick leaves the deadzone. A
+ * stick of which only one axis is used can instead be given a deadzone on each axis, so the
+ * unused axis cannot pull the used one out of its deadzone. The rescaled axes then go through
+ * a response curve of their own, chosen per axis.
+ *
+ * All of this is precomputed into tables when the deadzone or a curve is set: a rescaling gain
+ * for each stick distance and a 256-entry curve for each axis, so shaping a frame costs an
+ * integer square root per stick and a table load per axis.
+ */
+
+#ifndef SHAPING_H_
+#define SHAPING_H_
+
+#include <API.h>
+
+#include "input.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Response curves for shapingSetCurve(). SHAPE_CUBIC is v^3 over the axis range, and
+ * SHAPE_EXPO blends SHAPING_EXPO_PERCENT of the cubic curve with the linear one, keeping some
+ * response near the centre.
+ */
+#define SHAPE_LINEAR 0
+#define SHAPE_EXPO 1
+#define SHAPE_CUBIC 2
+/**
+ * Share of the cubic term in SHAPE_EXPO, in percent.
+ */
+#define SHAPING_EXPO_PERCENT 60
+
+/**
+ * Sticks for shapingSetDeadzoneShape(): the left one has axes 3 and 4, the right one 1 and 2.
+ */
+#define SHAPE_STICK_LEFT 0
+#define SHAPE_STICK_RIGHT 1
+/**
+ * Deadzone shapes. SHAPE_RADIAL applies the deadzone to the stick's distance from the centre,
+ * and SHAPE_AXIAL to each of its axes on its own.
+ */
+#define SHAPE_RADIAL 0
+#define SHAPE_AXIAL 1
+
+/**
+ * Sets the deadzone of both sticks, making both SHAPE_RADIAL, and resets every axis to
+ * SHAPE_LINEAR.
+ *
+ * @param deadzone the stick distance from the centre, 0 to 126, that still reads as centred
+ */
+void shapingInit(unsigned char deadzone);
+/**
+ * Sets the shape of one stick's deadzone.
+ *
+ * @param stick SHAPE_STICK_LEFT or SHAPE_STICK_RIGHT
+ * @param shape SHAPE_RADIAL or SHAPE_AXIAL
+ */
+void shapingSetDeadzoneShape(unsigned char stick, unsigned char shape);
+/**
+ * Sets the response curve of one axis.
+ *
+ * @param axis the axis number, 1 to 4
+ * @param curve one of the SHAPE_* curves
+ */
+void shapingSetCurve(unsigned char axis, unsigned char curve);
+/**
+ * Shapes every axis of a frame.
+ *
+ * @param frame the sampled frame
+ * @param axes receives the shaped axis values from -127 to 127; axes[0] holds axis 1
+ */
+void shapingApply(const InputFrame *frame, int axes[INPUT_AXES]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
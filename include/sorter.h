@@ -0,0 +1,123 @@
+/** @file sorter.h
+ * @brief Ball sorter with a FIFO of classified balls
+ *
+ * Balls classified by the driver or the Arduino are queued in order, and the sorter paddle
+ * handles them one after another. A ball that arrives while another is being sorted waits in
+ * the queue instead of being dropped; only a full queue drops balls, and those are counted.
+ *
+ * Each stroke moves the paddle SORTER_STROKE ticks to the next absolute encoder target along a
+ * trapezoidal velocity profile, tracked with velocity feedforward plus proportional feedback.
+ * The encoder is never reset, so an overshoot on one stroke is corrected on the next instead of
+ * accumulating, and the paddle holds its target between strokes.
+ */
+
+#ifndef SORTER_H_
+#define SORTER_H_
+
+#include <API.h>
+
+#include "sensors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of balls that can wait for the sorter. Must be a power of two.
+ */
+#define SORTER_QUEUE_SIZE 8
+/**
+ * Encoder ticks the paddle turns to sort one ball.
+ */
+#define SORTER_STROKE 90
+/**
+ * Profile cruise velocity (ticks/s) and acceleration (ticks/s^2) for one stroke.
+ */
+#define SORTER_MAX_VEL 450
+#define SORTER_ACCEL 3000
+/**
+ * Feedforward gain as a fraction: motor power per tick/s of planned velocity.
+ */
+#define SORTER_KV_NUM 127
+#define SORTER_KV_DEN 600
+/**
+ * Proportional gain: motor power per tick of position error.
+ */
+#define SORTER_KP 2
+/**
+ * Largest motor power the controller will command (93% of top speed).
+ */
+#define SORTER_MAX_POWER 118
+/**
+ * A stroke is settled once the error stays within SORTER_TOLERANCE ticks for SORTER_SETTLE_MS
+ * after the profile has finished. A stroke that has not settled SORTER_TIMEOUT_MS after the
+ * profile finished is abandoned so a jam cannot stall the queue. The paddle then takes the
+ * paddle position nearest to where it stopped as its target and is left unpowered until the
+ * next stroke, so it does not push into the jam.
+ */
+#define SORTER_TOLERANCE 3
+#define SORTER_SETTLE_MS 40
+#define SORTER_TIMEOUT_MS 500
+
+/**
+ * Sorter queue statistics since the last sorterInit(). Latencies are in microseconds, from
+ * the moment the ball was classified to the moment its paddle stroke finished.
+ */
+typedef struct {
+	// Balls currently waiting, not counting the one being sorted
+	unsigned int depth;
+	unsigned int maxDepth;
+	// Balls rejected because the queue was full
+	unsigned long dropped;
+	// Balls sorted to completion
+	unsigned long sorted;
+	unsigned long lastLatency;
+	unsigned long maxLatency;
+	unsigned long long totalLatency;
+	// Milliseconds from the start of a stroke until the paddle settled on its target
+	unsigned long lastSettle;
+	unsigned long maxSettle;
+	// Strokes abandoned because they did not settle in time; their balls are not counted as
+	// sorted
+	unsigned long timeouts;
+} SorterStats;
+
+/**
+ * Empties the queue and takes the paddle position nearest to the current encoder count as the
+ * target to hold.
+ */
+void sorterInit();
+/**
+ * Queues a classified ball.
+ *
+ * @param enemy true for an enemy ball, false for a friendly ball
+ * @param time micros() when the ball was classified, used for the latency statistics
+ * @return true if the ball was queued, false if the queue was full and it was dropped
+ */
+bool sorterEnqueue(bool enemy, unsigned long time);
+/**
+ * Advances the sorter by one control cycle: starts the next queued ball when idle, tracks the
+ * stroke in progress, and holds the paddle on its target otherwise. Commands the SORTER port
+ * through the motor output stage.
+ *
+ * @param sens the sensor frame for this cycle
+ */
+void sorterUpdate(const SensorFrame *sens);
+/**
+ * Checks whether the paddle is idle with no balls waiting.
+ *
+ * @return true if there is nothing to sort
+ */
+bool sorterIdle();
+/**
+ * Gets the sorter statistics.
+ *
+ * @return a pointer to the statistics, valid until the next sorterInit()
+ */
+const SorterStats* sorterGetStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
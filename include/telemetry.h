@@ -0,0 +1,186 @@
+/** @file telemetry.h
+ * @brief Non-blocking binary telemetry
+ *
+ * Control code enqueues fixed-size binary records with telemetryPush(), which takes constant
+ * time and never blocks: if the queue is full the record is dropped and counted. A task at
+ * TASK_PRIORITY_LOWEST drains the queue and writes the records to stdout as framed,
+ * checksummed packets (see wire.h), so slow serial output can never stretch a control cycle.
+ *
+ * The queue is a lock-free multi-producer ring: every slot carries a sequence number that
+ * producers claim with a compare-and-swap on the head, so telemetryPush() may be called from
+ * any task. It must not be called from an interrupt handler, which could preempt a producer
+ * between claiming a slot and publishing it.
+ *
+ * This header does not depend on API.h so the host-side decoder in tools/ can share the
+ * record definitions.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of records the queue can hold. Must be a power of two.
+ */
+#define TELEMETRY_QUEUE_SIZE 256
+/**
+ * Period of the telemetry task in milliseconds. Each cycle it handles any commands waiting on
+ * stdin, runs the sampler and then drains the whole queue.
+ */
+#define TELEMETRY_PERIOD_MS 100
+/**
+ * Maximum number of frames the telemetry task batches into one fwrite().
+ */
+#define TELEMETRY_DRAIN_BATCH 8
+
+/**
+ * Record types. The meaning of the channel field depends on the type.
+ */
+// Value written to a motor port; channel is the port
+#define TELEM_MOTOR 1
+// Encoder count; channel is the encoder's top port
+#define TELEM_ENCODER 2
+// Digital input level; channel is the pin
+#define TELEM_SWITCH 3
+// Control loop timing; channel is TELEM_LOOP_CHANNEL(task, metric)
+#define TELEM_LOOP 4
+// Profiler statistics (see prof.h); channel is TELEM_PROFILE_CHANNEL(section, field)
+#define TELEM_PROFILE 5
+// Lifter end stop statistics; channel is one of the TELEM_LIFTER_* values
+#define TELEM_LIFTER 6
+// Power manager state; channel is one of the TELEM_POWER_* values
+#define TELEM_POWER 7
+// Trajectory tracking; channel is one of the TELEM_TRAJECTORY_* values
+#define TELEM_TRAJECTORY 8
+// Driver input recorder statistics; channel is one of the TELEM_RECORDER_* values
+#define TELEM_RECORDER 9
+
+/**
+ * Channels of TELEM_LOOP records: the task in the high nibble and the metric in the low one.
+ */
+#define TELEM_LOOP_CHANNEL(task, metric) (((task) << 4) | (metric))
+// Tasks
+#define TELEM_TASK_DRIVE 0
+#define TELEM_TASK_MECHANISM 1
+#define TELEM_TASK_TELEMETRY 2
+// Measured period in microseconds
+#define TELEM_LOOP_PERIOD 0
+// Execution time in microseconds
+#define TELEM_LOOP_EXEC 1
+// Running overrun count
+#define TELEM_LOOP_OVERRUNS 2
+// Peak-to-peak period jitter in microseconds
+#define TELEM_LOOP_JITTER 3
+// Share of the CPU in tenths of a percent
+#define TELEM_LOOP_CPU 4
+
+/**
+ * Channels of TELEM_PROFILE records: the PROF_* section in the high nibble and the field in
+ * the low one.
+ */
+#define TELEM_PROFILE_CHANNEL(section, field) (((section) << 4) | (field))
+// Number of samples
+#define TELEM_PROFILE_COUNT 0
+// Shortest, longest and mean sample in microseconds
+#define TELEM_PROFILE_MIN 1
+#define TELEM_PROFILE_MAX 2
+#define TELEM_PROFILE_MEAN 3
+// Count in histogram bucket k is sent in field TELEM_PROFILE_BUCKET + k
+#define TELEM_PROFILE_BUCKET 4
+
+/**
+ * Channels of TELEM_LIFTER records.
+ */
+// Running count of interrupt cutoffs
+#define TELEM_LIFTER_CUTOFFS 0
+// Last interrupt handler to motor stopped latency in microseconds
+#define TELEM_LIFTER_STOP_LATENCY 1
+// Last delay from a cutoff to the control loop noticing it, in microseconds
+#define TELEM_LIFTER_POLL_DELAY 2
+
+/**
+ * Channels of TELEM_POWER records.
+ */
+// Filtered main and backup battery voltages in mV
+#define TELEM_POWER_MAIN 0
+#define TELEM_POWER_BACKUP 1
+// Estimated motor draw and the budget it is held to, in mA
+#define TELEM_POWER_DEMAND 2
+#define TELEM_POWER_BUDGET 3
+
+/**
+ * Channels of TELEM_TRAJECTORY records.
+ */
+// Position error in IME ticks of the wheel furthest off its plan, once per step
+#define TELEM_TRAJECTORY_ERROR 0
+
+/**
+ * Channels of TELEM_RECORDER records.
+ */
+// Frames and encoded bytes in the recording, and frames repeated to fill skipped cycles
+#define TELEM_RECORDER_FRAMES 0
+#define TELEM_RECORDER_BYTES 1
+#define TELEM_RECORDER_GAPS 2
+// Frames replayed so far, and the largest replay timing error in microseconds
+#define TELEM_RECORDER_REPLAYED 3
+#define TELEM_RECORDER_REPLAY_ERROR 4
+
+/**
+ * One telemetry sample.
+ */
+typedef struct {
+	// millis() when the sample was taken
+	uint32_t time;
+	// Sample value
+	int32_t value;
+	// One of the TELEM_* types
+	uint8_t type;
+	// Type-specific channel, e.g. the encoder's top port for TELEM_ENCODER
+	uint8_t channel;
+} TelemetryRecord;
+
+/**
+ * Clears the queue and starts the telemetry task. Call once from initialize().
+ */
+void telemetryInit();
+/**
+ * Sets a function the telemetry task calls at the start of every cycle, before draining, to
+ * push low-rate samples such as loop statistics.
+ *
+ * @param sampler the function to call, or NULL for none
+ */
+void telemetrySetSampler(void (*sampler)());
+/**
+ * Enqueues a sample stamped with the current time. Never blocks.
+ *
+ * @param type one of the TELEM_* types
+ * @param channel the type-specific channel
+ * @param value the sample value
+ * @return true if the record was queued, false if the queue was full and it was dropped
+ */
+bool telemetryPush(uint8_t type, uint8_t channel, int32_t value);
+/**
+ * Dequeues the oldest record. Only the telemetry task should call this.
+ *
+ * @param record receives the record
+ * @return true if a record was dequeued, false if the queue was empty
+ */
+bool telemetryPop(TelemetryRecord *record);
+/**
+ * Gets the number of records dropped because the queue was full.
+ *
+ * @return the overflow count since telemetryInit()
+ */
+uint32_t telemetryOverflows();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
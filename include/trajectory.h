@@ -0,0 +1,119 @@
+/** @file trajectory.h
+ * @brief Playback of precomputed drive trajectories
+ *
+ * A Trajectory is a const table, kept in flash, of the velocity of each drive wheel at every
+ * TRAJECTORY_PERIOD_MS step. The tables are generated offline by tools/mktraj.c, so the robot
+ * does no planning: each step reads the IMEs, adds up the position each wheel should have
+ * reached, and commands a feedforward from the planned velocity plus a proportional correction
+ * from the position error. Positions are accumulated exactly in integer milliticks, so the
+ * setpoint never drifts from the table. Nothing is allocated.
+ *
+ * Single moves can also be planned on the robot with trajectoryStartMove(), for callers such
+ * as the autonomous VM that only know their moves at run time. They are tracked the same way,
+ * with the setpoints taken from a trapezoid.h profile instead of a table.
+ *
+ * A wheel whose IME does not answer is driven on feedforward alone for that step.
+ */
+
+#ifndef TRAJECTORY_H_
+#define TRAJECTORY_H_
+
+#include <API.h>
+
+#include "drive.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Time between trajectory points in milliseconds.
+ */
+#define TRAJECTORY_PERIOD_MS DRIVE_PERIOD_MS
+/**
+ * Proportional gain on the position error: motor power per TRAJECTORY_KP_DEN ticks.
+ */
+#define TRAJECTORY_KP_NUM 1
+#define TRAJECTORY_KP_DEN 1
+
+/**
+ * One step of a trajectory.
+ */
+typedef struct {
+	// Velocity of each wheel in IME ticks per second, in DRIVE_* order
+	short velocity[DRIVE_WHEELS];
+} TrajectoryPoint;
+
+/**
+ * A trajectory: one point per TRAJECTORY_PERIOD_MS.
+ */
+typedef struct {
+	const TrajectoryPoint *points;
+	unsigned short length;
+} Trajectory;
+
+/**
+ * Tracking statistics of the last trajectory or move started. Errors are the planned position less
+ * the measured one, in IME ticks, for the wheel furthest off at each step.
+ */
+typedef struct {
+	// Steps run so far
+	unsigned long steps;
+	// Largest and mean error over the trajectory, and the error when it finished
+	unsigned long maxError;
+	unsigned long totalError;
+	unsigned long finalError;
+	// Steps a wheel ran open loop because its IME did not answer
+	unsigned long imeFailures;
+} TrajectoryStats;
+
+/**
+ * Starts following a trajectory from the wheels' present positions.
+ *
+ * @param trajectory the trajectory to follow
+ */
+void trajectoryStart(const Trajectory *trajectory);
+/**
+ * Starts a move from the wheels' present positions. The wheel that travels furthest follows a
+ * trapezoidal profile and the others keep in proportion, so all four start and stop together.
+ *
+ * @param forward the forward travel in IME ticks of wheel travel
+ * @param strafe the sideways travel in IME ticks, positive in the direction driveMix() strafes
+ * @param turn the turn in IME ticks of wheel travel, positive as driveMix() turns
+ * @param maxVel the lead wheel's top velocity in ticks per second, greater than 0
+ * @param accel the lead wheel's acceleration in ticks per second squared, greater than 0
+ */
+void trajectoryStartMove(int forward, int strafe, int turn, unsigned int maxVel,
+	unsigned int accel);
+/**
+ * Checks whether a trajectory or move is still running.
+ *
+ * @return true until trajectoryStep() has finished it
+ */
+bool trajectoryActive();
+/**
+ * Runs one step of the trajectory: commands the drive motors for the next point. The caller
+ * flushes DRIVE_PORTS and calls this every TRAJECTORY_PERIOD_MS.
+ *
+ * @return true while the trajectory has points left; false once it has finished, when the
+ * drive has been commanded to stop
+ */
+bool trajectoryStep();
+/**
+ * Follows a trajectory to its end at a fixed rate, flushing the drive every step.
+ *
+ * @param trajectory the trajectory to follow
+ */
+void trajectoryRun(const Trajectory *trajectory);
+/**
+ * Gets the tracking statistics.
+ *
+ * @return a pointer to the statistics, reset by trajectoryStart()
+ */
+const TrajectoryStats* trajectoryGetStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,79 @@
+/** @file trapezoid.h
+ * @brief Trapezoidal velocity profiles in integer arithmetic
+ *
+ * A Trapezoid plans a move between two absolute positions that accelerates at a constant
+ * rate, cruises at a maximum velocity, and decelerates to rest on the target. Moves too short
+ * to reach the maximum velocity become triangular. Positions are in encoder ticks, velocities
+ * in ticks per second, accelerations in ticks per second squared and times in milliseconds.
+ * Only integer math is used since the Cortex-M3 has no FPU.
+ */
+
+#ifndef TRAPEZOID_H_
+#define TRAPEZOID_H_
+
+#include <API.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A planned move.
+ */
+typedef struct {
+	// Position the move starts from
+	int start;
+	// Length of the move (always positive) and its direction (1 or -1)
+	int distance;
+	int direction;
+	// Acceleration and the velocity actually reached
+	unsigned int accel;
+	unsigned int peakVel;
+	// millis() when the move starts
+	unsigned long startTime;
+	// Duration of the acceleration (and deceleration) phase and of the cruise phase
+	unsigned long accelTime;
+	unsigned long cruiseTime;
+} Trapezoid;
+
+/**
+ * Plans a move.
+ *
+ * @param profile the profile to fill
+ * @param from the starting position
+ * @param to the target position
+ * @param maxVel the cruise velocity limit, greater than 0
+ * @param accel the acceleration, greater than 0
+ * @param startTime millis() at which the move starts
+ */
+void trapezoidPlan(Trapezoid *profile, int from, int to, unsigned int maxVel,
+	unsigned int accel, unsigned long startTime);
+/**
+ * Gets the planned position at a point in time.
+ *
+ * @param profile the planned move
+ * @param now the current millis()
+ * @return the position setpoint; the start before the move and the target after it
+ */
+int trapezoidPosition(const Trapezoid *profile, unsigned long now);
+/**
+ * Gets the planned signed velocity at a point in time.
+ *
+ * @param profile the planned move
+ * @param now the current millis()
+ * @return the velocity setpoint in ticks per second
+ */
+int trapezoidVelocity(const Trapezoid *profile, unsigned long now);
+/**
+ * Gets the total duration of a move.
+ *
+ * @param profile the planned move
+ * @return the duration in milliseconds
+ */
+unsigned long trapezoidDuration(const Trapezoid *profile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
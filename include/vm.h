@@ -0,0 +1,142 @@
+/** @file vm.h
+ * @brief Bytecode interpreter for autonomous routines
+ *
+ * Autonomous routines can be written as small bytecode programs, assembled on the workstation by
+ * tools/vmasm.c and kept in a flash file, so a routine can be changed without reflashing the
+ * firmware. vmLoad() reads the program into a fixed buffer at initialize() and checks every
+ * instruction once: opcodes, operand ranges and fork targets. Execution then needs no checks.
+ *
+ * A program runs as up to VM_THREADS threads. PARALLEL starts another thread at a label, and JOIN
+ * waits for every other thread to finish. Only the first thread may JOIN: vmLoad() rejects a JOIN a
+ * forked thread would reach, since two joining threads wait on each other. Instructions that wait
+ * (motion, WAIT and the sensor waits) never block the caller: the thread stays on the instruction
+ * and retries it the next tick. vmTick() runs each thread until it waits or ends, up to
+ * VM_TICK_BUDGET instructions, so one tick always fits in a DRIVE_PERIOD_MS control cycle. Nothing
+ * is allocated.
+ *
+ * Program encoding: each instruction is an opcode byte followed by its operands, little endian.
+ *
+ *     END                                  end this thread
+ *     DRIVE ticks:i16                      move forward by ticks of wheel travel
+ *     STRAFE ticks:i16                     move sideways as driveMix() strafes
+ *     TURN ticks:i16                       turn by ticks of wheel travel, as driveMix() turns
+ *     LIMITS vel:u16 accel:u16             wheel ticks/s and ticks/s^2 for later moves
+ *     MOTOR port:u8 speed:i8               command a mechanism motor
+ *     WAIT ms:u16                          wait
+ *     WAITPIN pin:u8 level:u8 timeout:u16  wait for a digital pin to read level
+ *     WAITABOVE channel:u8 value:u16 timeout:u16
+ *     WAITBELOW channel:u8 value:u16 timeout:u16
+ *                                          wait for an analog channel to pass value
+ *     PARALLEL address:u16                 start a thread at the instruction at address
+ *     JOIN                                 wait for every other thread to end
+ *
+ * Motion instructions wait for any move in progress, start theirs with trajectoryStartMove() and
+ * wait for that move, not a later one another thread starts, to finish. A sensor wait that times
+ * out carries on and is counted.
+ */
+
+#ifndef VM_H_
+#define VM_H_
+
+#include <API.h>
+
+#include "sensors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Largest program in bytes.
+ */
+#define VM_PROGRAM_SIZE 1024
+/**
+ * Threads that can run at once, including the first.
+ */
+#define VM_THREADS 4
+/**
+ * Instructions one thread may run in one tick before it yields to the next.
+ */
+#define VM_TICK_BUDGET 16
+/**
+ * Flash file the program is kept in.
+ */
+#define VM_FILE "routine"
+/**
+ * Magic of a program file, followed by the program length as a u16 and the program.
+ */
+#define VM_MAGIC "AVM1"
+
+/**
+ * Opcodes.
+ */
+#define VM_END 0
+#define VM_DRIVE 1
+#define VM_STRAFE 2
+#define VM_TURN 3
+#define VM_LIMITS 4
+#define VM_MOTOR 5
+#define VM_WAIT 6
+#define VM_WAITPIN 7
+#define VM_WAITABOVE 8
+#define VM_WAITBELOW 9
+#define VM_PARALLEL 10
+#define VM_JOIN 11
+#define VM_OPCODES 12
+
+/**
+ * Execution statistics of the last run.
+ */
+typedef struct {
+	// Ticks run and instructions executed, in total and by opcode
+	unsigned long ticks;
+	unsigned long instructions;
+	unsigned long executed[VM_OPCODES];
+	// Most instructions executed in one tick
+	unsigned long maxPerTick;
+	// Sensor waits that timed out
+	unsigned long timeouts;
+} VmStats;
+
+/**
+ * Reads a program from a flash file and checks it.
+ *
+ * @param file the flash file name
+ * @return true if a valid program was read; otherwise no program is loaded
+ */
+bool vmLoad(const char *file);
+/**
+ * Checks whether a program is loaded.
+ *
+ * @return true if vmLoad() last succeeded
+ */
+bool vmLoaded();
+/**
+ * Starts the loaded program from its first instruction on one thread.
+ */
+void vmStart();
+/**
+ * Runs every thread until it waits, ends or uses up its VM_TICK_BUDGET. The caller steps the
+ * trajectory and flushes the motors around it.
+ *
+ * @param frame the sensors sampled this cycle
+ * @return true while any thread is running
+ */
+bool vmTick(const SensorFrame *frame);
+/**
+ * Runs the loaded program to its end at DRIVE_PERIOD_MS, stepping the trajectory, updating the
+ * power manager and flushing the motors every tick. Call powerInit() first.
+ */
+void vmRun();
+/**
+ * Gets the execution statistics.
+ *
+ * @return a pointer to the statistics, reset by vmStart()
+ */
+const VmStats* vmGetStats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
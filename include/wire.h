@@ -0,0 +1,89 @@
+/** @file wire.h
+ * @brief Framed, checksummed telemetry wire format
+ *
+ * Each telemetry record goes out as one frame:
+ *
+ *     COBS(seq[1] time[4] type[1] channel[1] value[4] crc[2]) 0x00
+ *
+ * Multi-byte fields are little-endian. seq increments by one per frame so the receiver can
+ * count lost frames, and crc is CRC-16/CCITT-FALSE over the preceding 11 bytes. COBS removes
+ * every zero byte from the frame body so the 0x00 delimiter always marks a frame boundary and
+ * a receiver can resynchronize after corruption by skipping to the next zero.
+ *
+ * This module has no dependency on the PROS API and is compiled into both the robot program
+ * and the host-side decoder.
+ */
+
+#ifndef WIRE_H_
+#define WIRE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "telemetry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Size of a decoded frame body including the CRC.
+ */
+#define WIRE_PAYLOAD_SIZE 13
+/**
+ * Maximum size of an encoded frame including the COBS overhead byte and the delimiter.
+ */
+#define WIRE_FRAME_MAX (WIRE_PAYLOAD_SIZE + 2)
+
+/**
+ * Computes CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+ *
+ * @param data the bytes to checksum
+ * @param len the number of bytes
+ * @return the CRC
+ */
+uint16_t wireCrc16(const uint8_t *data, size_t len);
+/**
+ * COBS-encodes a buffer. The output never contains a zero byte and is not delimited.
+ *
+ * @param in the bytes to encode
+ * @param len the number of bytes, at most 254
+ * @param out receives len + 1 bytes
+ * @return the number of bytes written to out
+ */
+size_t wireCobsEncode(const uint8_t *in, size_t len, uint8_t *out);
+/**
+ * Decodes a COBS buffer that has had its delimiter stripped.
+ *
+ * @param in the encoded bytes
+ * @param len the number of encoded bytes
+ * @param out receives at most len - 1 bytes
+ * @return the number of decoded bytes, or 0 if the input is not valid COBS
+ */
+size_t wireCobsDecode(const uint8_t *in, size_t len, uint8_t *out);
+/**
+ * Encodes a record as a complete frame including the trailing delimiter.
+ *
+ * @param seq the frame sequence number
+ * @param record the record to send
+ * @param out receives at most WIRE_FRAME_MAX bytes
+ * @return the number of bytes written to out
+ */
+size_t wireEncodeFrame(uint8_t seq, const TelemetryRecord *record, uint8_t *out);
+/**
+ * Decodes and verifies one frame.
+ *
+ * @param frame the encoded frame without its delimiter
+ * @param len the number of bytes in frame
+ * @param seq receives the frame sequence number
+ * @param record receives the record
+ * @return true if the frame decoded and its CRC matched
+ */
+bool wireDecodeFrame(const uint8_t *frame, size_t len, uint8_t *seq, TelemetryRecord *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,165 @@
+/** @file host.c
+ * @brief Host C library services for the simulator
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "host.h"
+
+#define HOST_MAX_FILES 8
+
+static FILE *capture;
+static FILE *files[HOST_MAX_FILES];
+static char flashDir[256] = ".";
+
+static FILE* hostStream(int stream)
+{
+	return stream == HOST_STDERR ? stderr : stdout;
+}
+
+void hostWrite(int stream, const void *data, size_t len)
+{
+	fwrite(data, 1, len, hostStream(stream));
+}
+
+int hostVsnprintf(char *buffer, size_t limit, const char *format, va_list args)
+{
+	return vsnprintf(buffer, limit, format, args);
+}
+
+int hostVprintf(int stream, const char *format, va_list args)
+{
+	return vfprintf(hostStream(stream), format, args);
+}
+
+int hostCaptureOpen(const char *path)
+{
+	capture = fopen(path, "wb");
+	return capture == NULL ? -1 : 0;
+}
+
+void hostCaptureWrite(const void *data, size_t len)
+{
+	if (capture != NULL)
+		fwrite(data, 1, len, capture);
+}
+
+void hostFlashDir(const char *dir)
+{
+	snprintf(flashDir, sizeof(flashDir), "%s", dir);
+}
+
+static void hostFlashPath(const char *name, char *path, size_t limit)
+{
+	// PROS truncates file names to eight characters
+	snprintf(path, limit, "%s/%.8s", flashDir, name);
+}
+
+int hostFileOpen(const char *name, const char *mode)
+{
+	char path[300];
+	int i;
+
+	if (strcmp(mode, "r") != 0 && strcmp(mode, "w") != 0)
+		return -1;
+	for (i = 0; i < HOST_MAX_FILES; i++)
+		if (files[i] == NULL)
+		{
+			hostFlashPath(name, path, sizeof(path));
+			files[i] = fopen(path, mode[0] == 'r' ? "rb" : "wb");
+			return files[i] == NULL ? -1 : i + 1;
+		}
+	return -1;
+}
+
+static FILE* hostFile(int handle)
+{
+	if (handle < 1 || handle > HOST_MAX_FILES)
+		return NULL;
+	return files[handle - 1];
+}
+
+void hostFileClose(int handle)
+{
+	FILE *f = hostFile(handle);
+
+	if (f != NULL)
+	{
+		fclose(f);
+		files[handle - 1] = NULL;
+	}
+}
+
+size_t hostFileRead(int handle, void *data, size_t len)
+{
+	FILE *f = hostFile(handle);
+	return f == NULL ? 0 : fread(data, 1, len, f);
+}
+
+size_t hostFileWrite(int handle, const void *data, size_t len)
+{
+	FILE *f = hostFile(handle);
+	return f == NULL ? 0 : fwrite(data, 1, len, f);
+}
+
+int hostFileGetc(int handle)
+{
+	FILE *f = hostFile(handle);
+	return f == NULL ? EOF : fgetc(f);
+}
+
+int hostFileEof(int handle)
+{
+	FILE *f = hostFile(handle);
+	return f == NULL || feof(f);
+}
+
+int hostFileSeek(int handle, long offset, int origin)
+{
+	FILE *f = hostFile(handle);
+	return f == NULL ? -1 : fseek(f, offset, origin);
+}
+
+long hostFileTell(int handle)
+{
+	FILE *f = hostFile(handle);
+	return f == NULL ? -1 : ftell(f);
+}
+
+int hostFileDelete(const char *name)
+{
+	char path[300];
+
+	hostFlashPath(name, path, sizeof(path));
+	return remove(path) == 0 ? 1 : 0;
+}
+
+unsigned long long hostWallMicros()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+unsigned long hostThreadMicros()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (unsigned long)((unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+unsigned long long hostCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
@@ -0,0 +1,76 @@
+/** @file host.h
+ * @brief Host C library services for the simulator
+ *
+ * The simulator's PROS API implementation cannot include <stdio.h> because API.h declares
+ * functions and macros with the same names. These wrappers are compiled separately against the
+ * real C library and only use plain C types in their interface.
+ */
+
+#ifndef HOST_H_
+#define HOST_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/**
+ * Host streams the simulator writes to.
+ */
+#define HOST_STDOUT 1
+#define HOST_STDERR 2
+
+/**
+ * Writes raw bytes to a host stream.
+ */
+void hostWrite(int stream, const void *data, size_t len);
+/**
+ * Formats into a buffer like vsnprintf().
+ */
+int hostVsnprintf(char *buffer, size_t limit, const char *format, va_list args);
+/**
+ * Formats to a host stream like vfprintf().
+ */
+int hostVprintf(int stream, const char *format, va_list args);
+
+/**
+ * Opens the file that receives everything the robot writes to its stdout, replacing the
+ * default of discarding it.
+ *
+ * @return 0 on success, -1 if the file could not be opened
+ */
+int hostCaptureOpen(const char *path);
+/**
+ * Writes to the capture file if one is open.
+ */
+void hostCaptureWrite(const void *data, size_t len);
+
+/**
+ * Flash file system emulation. Files live in the host directory given to hostFlashDir().
+ * Handles are small positive integers, or -1 on failure.
+ */
+void hostFlashDir(const char *dir);
+int hostFileOpen(const char *name, const char *mode);
+void hostFileClose(int handle);
+size_t hostFileRead(int handle, void *data, size_t len);
+size_t hostFileWrite(int handle, const void *data, size_t len);
+int hostFileGetc(int handle);
+int hostFileEof(int handle);
+int hostFileSeek(int handle, long offset, int origin);
+long hostFileTell(int handle);
+int hostFileDelete(const char *name);
+
+/**
+ * Gets the host's monotonic clock in microseconds, for reporting simulation speed.
+ */
+unsigned long long hostWallMicros();
+/**
+ * Gets the CPU time the calling thread has used in microseconds. The profiler (prof.h) uses
+ * this in the simulation instead of micros(), which does not advance while code runs.
+ */
+unsigned long hostThreadMicros();
+/**
+ * Reads a cycle counter for the host benchmarks in tools/: the time-stamp counter on x86, and
+ * the monotonic clock in nanoseconds elsewhere.
+ */
+unsigned long long hostCycles();
+
+#endif
@@ -0,0 +1,158 @@
+/** @file scenario.c
+ * @brief Scenario files for the simulator
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "scenario.h"
+
+static int scenarioButton(const char *name)
+{
+	if (strcmp(name, "down") == 0)
+		return SCENARIO_JOY_DOWN;
+	if (strcmp(name, "left") == 0)
+		return SCENARIO_JOY_LEFT;
+	if (strcmp(name, "up") == 0)
+		return SCENARIO_JOY_UP;
+	if (strcmp(name, "right") == 0)
+		return SCENARIO_JOY_RIGHT;
+	return 0;
+}
+
+// Comparisons of expect events, from SCENARIO_LT
+static const char *comparisons[] = { "<", "<=", "==", "!=", ">=", ">" };
+
+static int scenarioComparison(const char *name)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(comparisons) / sizeof(comparisons[0]); i++)
+		if (strcmp(name, comparisons[i]) == 0)
+			return SCENARIO_LT + i;
+	return 0;
+}
+
+const char* scenarioComparisonName(int comparison)
+{
+	return comparisons[comparison - SCENARIO_LT];
+}
+
+static int scenarioParse(const char *line, ScenarioEvent *event)
+{
+	char kind[16];
+	char name[16];
+	int n;
+
+	if (sscanf(line, "%lu %15s%n", &event->time, kind, &n) < 2)
+		return 0;
+	line += n;
+	event->a = event->b = event->c = 0;
+	if (strcmp(kind, "axis") == 0)
+	{
+		event->kind = SCENARIO_AXIS;
+		return sscanf(line, "%d %d", &event->a, &event->b) == 2;
+	}
+	if (strcmp(kind, "button") == 0)
+	{
+		event->kind = SCENARIO_BUTTON;
+		if (sscanf(line, "%d %15s %d", &event->a, name, &event->c) != 3)
+			return 0;
+		event->b = scenarioButton(name);
+		return event->b != 0;
+	}
+	if (strcmp(kind, "pin") == 0)
+	{
+		event->kind = SCENARIO_PIN;
+		return sscanf(line, "%d %d", &event->a, &event->b) == 2;
+	}
+	if (strcmp(kind, "ball") == 0)
+	{
+		event->kind = SCENARIO_BALL;
+		if (sscanf(line, "%15s", name) != 1)
+			return 0;
+		event->a = strcmp(name, "enemy") == 0;
+		return event->a || strcmp(name, "friendly") == 0;
+	}
+	if (strcmp(kind, "auto") == 0)
+	{
+		event->kind = SCENARIO_AUTO;
+		return sscanf(line, "%d", &event->a) == 1;
+	}
+	if (strcmp(kind, "battery") == 0)
+	{
+		event->kind = SCENARIO_BATTERY;
+		return sscanf(line, "%d %d", &event->a, &event->b) == 2;
+	}
+	if (strcmp(kind, "slew") == 0)
+	{
+		event->kind = SCENARIO_SLEW;
+		return sscanf(line, "%d %d %d", &event->a, &event->b, &event->c) == 3;
+	}
+	if (strcmp(kind, "serial") == 0)
+	{
+		event->kind = SCENARIO_SERIAL;
+		return sscanf(line, "%23s", event->text) == 1;
+	}
+	if (strcmp(kind, "expect") == 0)
+	{
+		event->kind = SCENARIO_EXPECT;
+		if (sscanf(line, "%23s %15s %d", event->text, name, &event->b) == 3 &&
+			(event->c = scenarioComparison(name)) != 0)
+			return 1;
+		if (sscanf(line, "%23s %d %15s %d", event->text, &event->a, name, &event->b) == 4)
+			event->c = scenarioComparison(name);
+		return event->c != 0;
+	}
+	if (strcmp(kind, "end") == 0)
+	{
+		event->kind = SCENARIO_END;
+		return 1;
+	}
+	return 0;
+}
+
+int scenarioLoad(const char *path, ScenarioEvent *events, int max)
+{
+	FILE *f = fopen(path, "r");
+	char line[256];
+	int count = 0;
+	int lineNo = 0;
+	int i, j;
+
+	if (f == NULL)
+	{
+		perror(path);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		char *hash = strchr(line, '#');
+		char probe[2];
+
+		lineNo++;
+		if (hash != NULL)
+			*hash = '\0';
+		if (sscanf(line, "%1s", probe) != 1)
+			continue;
+		if (count == max || !scenarioParse(line, &events[count]))
+		{
+			fprintf(stderr, "%s:%d: %s\n", path, lineNo,
+				count == max ? "too many events" : "bad event");
+			fclose(f);
+			return -1;
+		}
+		count++;
+	}
+	fclose(f);
+
+	// Stable insertion sort by time
+	for (i = 1; i < count; i++)
+	{
+		ScenarioEvent e = events[i];
+		for (j = i; j > 0 && events[j - 1].time > e.time; j--)
+			events[j] = events[j - 1];
+		events[j] = e;
+	}
+	return count;
+}
@@ -0,0 +1,83 @@
+/** @file scenario.h
+ * @brief Scenario files for the simulator
+ *
+ * A scenario is a text file of timed input events, one per line, with '#' starting a comment:
+ *
+ *     <ms> axis <1-4> <value>              set a joystick 1 axis
+ *     <ms> button <5-8> <up|down|left|right> <0|1>   release or press a joystick 1 button
+ *     <ms> pin <1-12> <0|1>                drive a digital input
+ *     <ms> ball <friendly|enemy>           have the Arduino report a ball
+ *     <ms> auto <0|1>                      switch between operator control and autonomous
+ *     <ms> serial <text>                   send text to the robot's stdin
+ *     <ms> battery <main mV> <backup mV>   set the battery voltages
+ *     <ms> slew <1-10> <accel> <decel>     change a motor's slew limits (0 for none)
+ *     <ms> expect <metric> [port] <op> <value>   check a value the robot or plant reports
+ *     <ms> end                             end the run, unless robot-sim -t is given
+ *
+ * Events are applied in time order; events with equal times keep their file order.
+ *
+ * An expect event compares an integer metric with a value, using one of <, <=, ==, !=, >= or
+ * >, at the event's time. The metrics are named in simMetrics in sim/main.c; "motor" takes a
+ * port. The simulator reports every failed check on stderr and exits with status 1 if any
+ * check failed or the run ended before reaching it, which lets scenarios serve as tests.
+ */
+
+#ifndef SCENARIO_H_
+#define SCENARIO_H_
+
+#define SCENARIO_AXIS 1
+#define SCENARIO_BUTTON 2
+#define SCENARIO_PIN 3
+#define SCENARIO_BALL 4
+#define SCENARIO_AUTO 5
+#define SCENARIO_SERIAL 6
+#define SCENARIO_BATTERY 7
+#define SCENARIO_EXPECT 8
+#define SCENARIO_END 9
+#define SCENARIO_SLEW 10
+
+/**
+ * Comparisons in SCENARIO_EXPECT events.
+ */
+#define SCENARIO_LT 1
+#define SCENARIO_LE 2
+#define SCENARIO_EQ 3
+#define SCENARIO_NE 4
+#define SCENARIO_GE 5
+#define SCENARIO_GT 6
+
+/**
+ * Button ids in SCENARIO_BUTTON events, matching the PROS JOY_* values.
+ */
+#define SCENARIO_JOY_DOWN 1
+#define SCENARIO_JOY_LEFT 2
+#define SCENARIO_JOY_UP 4
+#define SCENARIO_JOY_RIGHT 8
+
+typedef struct {
+	unsigned long time;
+	int kind;
+	// Kind-specific arguments: axis/value, group/button/pressed, pin/level, enemy, enabled,
+	// main/backup, port/value/comparison, port/accel/decel
+	int a;
+	int b;
+	int c;
+	// Text of a SCENARIO_SERIAL event, or metric of a SCENARIO_EXPECT event
+	char text[24];
+} ScenarioEvent;
+
+/**
+ * Gets the text of a SCENARIO_EXPECT comparison, such as "<=".
+ */
+const char* scenarioComparisonName(int comparison);
+/**
+ * Loads and time-sorts a scenario file.
+ *
+ * @param path the file to read
+ * @param events receives the events
+ * @param max the capacity of events
+ * @return the number of events loaded, or -1 on a read or syntax error (reported on stderr)
+ */
+int scenarioLoad(const char *path, ScenarioEvent *events, int max);
+
+#endif
@@ -0,0 +1,442 @@
+/** @file io.c
+ * @brief Simulated motors, sensors, joystick and competition state
+ */
+
+#include "main.h"
+#include "sim.h"
+
+#define SIM_PINS 12
+#define SIM_ENCODERS 8
+// IMEs on the chain, one per drive wheel
+#define SIM_IMES DRIVE_WHEELS
+
+typedef struct {
+	unsigned char portTop;
+	bool reverse;
+	bool used;
+	int offset;
+} SimEncoder;
+
+static int motors[MOTOR_PORTS + 1];
+static unsigned long motorWrites[MOTOR_PORTS + 1];
+
+// Digital levels default HIGH, as inputs have pull-ups
+static bool levels[SIM_PINS + 1] = {
+	HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH
+};
+static unsigned char modes[SIM_PINS + 1];
+static InterruptHandler handlers[SIM_PINS + 1];
+static unsigned char edges[SIM_PINS + 1];
+
+static int analog[BOARD_NR_ADC_PINS + 1];
+static int axes[INPUT_AXES + 1];
+static unsigned char buttons[9];
+
+static int encoderCounts[SIM_PINS + 1];
+static SimEncoder encoders[SIM_ENCODERS];
+
+static int imeCounts[SIM_IMES];
+static int imeVelocities[SIM_IMES];
+static int imeOffsets[SIM_IMES];
+
+static bool autonomousMode;
+static unsigned int batteryMain = 7800;
+static unsigned int batteryBackup = 9000;
+
+void simJoystickAxis(unsigned char axis, int value)
+{
+	if (axis >= 1 && axis <= INPUT_AXES)
+		axes[axis] = value;
+}
+
+void simJoystickButton(unsigned char group, unsigned char button, bool pressed)
+{
+	if (group < 5 || group > 8)
+		return;
+	if (pressed)
+		buttons[group] |= button;
+	else
+		buttons[group] &= ~button;
+}
+
+void simDigitalInput(unsigned char pin, bool level)
+{
+	bool old;
+
+	if (pin < 1 || pin > SIM_PINS)
+		return;
+	old = levels[pin];
+	levels[pin] = level;
+	if (old == level || handlers[pin] == NULL)
+		return;
+	if ((level && (edges[pin] & INTERRUPT_EDGE_RISING)) ||
+		(!level && (edges[pin] & INTERRUPT_EDGE_FALLING)))
+		handlers[pin](pin);
+}
+
+void simEncoderSet(unsigned char portTop, int count)
+{
+	if (portTop >= 1 && portTop <= SIM_PINS)
+		encoderCounts[portTop] = count;
+}
+
+void simImeSet(unsigned char address, int count, int velocity)
+{
+	if (address < SIM_IMES)
+	{
+		imeCounts[address] = count;
+		imeVelocities[address] = velocity;
+	}
+}
+
+void simAnalogInput(unsigned char channel, int value)
+{
+	if (channel >= 1 && channel <= BOARD_NR_ADC_PINS)
+		analog[channel] = value;
+}
+
+void simSetAutonomous(bool value)
+{
+	autonomousMode = value;
+}
+
+void simSetBattery(unsigned int mainMv, unsigned int backupMv)
+{
+	batteryMain = mainMv;
+	batteryBackup = backupMv;
+}
+
+unsigned long simMotorWrites(unsigned char channel)
+{
+	return channel >= 1 && channel <= MOTOR_PORTS ? motorWrites[channel] : 0;
+}
+
+// Competition state and joystick
+
+bool isAutonomous()
+{
+	return autonomousMode;
+}
+
+bool isEnabled()
+{
+	return true;
+}
+
+bool isJoystickConnected(unsigned char joystick)
+{
+	return joystick == 1;
+}
+
+bool isOnline()
+{
+	return false;
+}
+
+int joystickGetAnalog(unsigned char joystick, unsigned char axis)
+{
+	if (joystick != 1 || axis < 1 || axis > INPUT_AXES)
+		return 0;
+	return axes[axis];
+}
+
+bool joystickGetDigital(unsigned char joystick, unsigned char buttonGroup, unsigned char button)
+{
+	if (joystick != 1 || buttonGroup < 5 || buttonGroup > 8)
+		return false;
+	return (buttons[buttonGroup] & button) != 0;
+}
+
+unsigned int powerLevelBackup()
+{
+	return batteryBackup;
+}
+
+unsigned int powerLevelMain()
+{
+	return batteryMain;
+}
+
+void setTeamName(const char *name)
+{
+}
+
+// Digital and analog I/O
+
+int analogCalibrate(unsigned char channel)
+{
+	return analogRead(channel);
+}
+
+int analogRead(unsigned char channel)
+{
+	if (channel < 1 || channel > BOARD_NR_ADC_PINS)
+		return 0;
+	return analog[channel];
+}
+
+int analogReadCalibrated(unsigned char channel)
+{
+	return analogRead(channel);
+}
+
+int analogReadCalibratedHR(unsigned char channel)
+{
+	return analogRead(channel) * 16;
+}
+
+bool digitalRead(unsigned char pin)
+{
+	if (pin < 1 || pin > SIM_PINS)
+		return LOW;
+	return levels[pin];
+}
+
+void digitalWrite(unsigned char pin, bool value)
+{
+	if (pin >= 1 && pin <= SIM_PINS && modes[pin] != INPUT)
+		levels[pin] = value;
+}
+
+void pinMode(unsigned char pin, unsigned char mode)
+{
+	if (pin >= 1 && pin <= SIM_PINS)
+		modes[pin] = mode;
+}
+
+void ioClearInterrupt(unsigned char pin)
+{
+	if (pin >= 1 && pin <= SIM_PINS)
+		handlers[pin] = NULL;
+}
+
+void ioSetInterrupt(unsigned char pin, unsigned char edgeMask, InterruptHandler handler)
+{
+	if (pin < 1 || pin > SIM_PINS)
+		return;
+	edges[pin] = edgeMask;
+	handlers[pin] = handler;
+}
+
+// Motors
+
+int motorGet(unsigned char channel)
+{
+	if (channel < 1 || channel > MOTOR_PORTS)
+		return 0;
+	return motors[channel];
+}
+
+void motorSet(unsigned char channel, int speed)
+{
+	if (channel < 1 || channel > MOTOR_PORTS)
+		return;
+	if (speed > 127)
+		speed = 127;
+	else if (speed < -127)
+		speed = -127;
+	motors[channel] = speed;
+	motorWrites[channel]++;
+}
+
+void motorStop(unsigned char channel)
+{
+	motorSet(channel, 0);
+}
+
+void motorStopAll()
+{
+	unsigned char i;
+
+	for (i = 1; i <= MOTOR_PORTS; i++)
+		motorStop(i);
+}
+
+// Encoders
+
+Encoder encoderInit(unsigned char portTop, unsigned char portBottom, bool reverse)
+{
+	int i;
+
+	for (i = 0; i < SIM_ENCODERS; i++)
+		if (!encoders[i].used)
+		{
+			encoders[i].used = true;
+			encoders[i].portTop = portTop;
+			encoders[i].reverse = reverse;
+			encoders[i].offset = 0;
+			encoderReset(&encoders[i]);
+			return &encoders[i];
+		}
+	return NULL;
+}
+
+int encoderGet(Encoder enc)
+{
+	SimEncoder *e = (SimEncoder*)enc;
+	int raw;
+
+	if (e == NULL)
+		return 0;
+	raw = encoderCounts[e->portTop];
+	return (e->reverse ? -raw : raw) - e->offset;
+}
+
+void encoderReset(Encoder enc)
+{
+	SimEncoder *e = (SimEncoder*)enc;
+
+	if (e != NULL)
+	{
+		e->offset = 0;
+		e->offset = encoderGet(enc);
+	}
+}
+
+void encoderShutdown(Encoder enc)
+{
+	if (enc != NULL)
+		((SimEncoder*)enc)->used = false;
+}
+
+// Integrated motor encoders
+
+unsigned int imeInitializeAll()
+{
+	return SIM_IMES;
+}
+
+bool imeGet(unsigned char address, int *value)
+{
+	if (address >= SIM_IMES)
+		return false;
+	*value = imeCounts[address] - imeOffsets[address];
+	return true;
+}
+
+bool imeGetVelocity(unsigned char address, int *value)
+{
+	if (address >= SIM_IMES)
+		return false;
+	*value = imeVelocities[address];
+	return true;
+}
+
+bool imeReset(unsigned char address)
+{
+	if (address >= SIM_IMES)
+		return false;
+	imeOffsets[address] = imeCounts[address];
+	return true;
+}
+
+// Devices the robot does not have; they behave as if nothing is connected
+
+void speakerInit()
+{
+}
+
+void speakerPlayArray(const char * * songs)
+{
+}
+
+void speakerPlayRtttl(const char *song)
+{
+}
+
+void speakerShutdown()
+{
+}
+
+void imeShutdown()
+{
+}
+
+int gyroGet(Gyro gyro)
+{
+	return 0;
+}
+
+Gyro gyroInit(unsigned char port, unsigned short multiplier)
+{
+	return NULL;
+}
+
+void gyroReset(Gyro gyro)
+{
+}
+
+void gyroShutdown(Gyro gyro)
+{
+}
+
+int ultrasonicGet(Ultrasonic ult)
+{
+	return ULTRA_BAD_RESPONSE;
+}
+
+Ultrasonic ultrasonicInit(unsigned char portEcho, unsigned char portPing)
+{
+	return NULL;
+}
+
+void ultrasonicShutdown(Ultrasonic ult)
+{
+}
+
+bool i2cRead(uint8_t addr, uint8_t *data, uint16_t count)
+{
+	return false;
+}
+
+bool i2cReadRegister(uint8_t addr, uint8_t reg, uint8_t *value, uint16_t count)
+{
+	return false;
+}
+
+bool i2cWrite(uint8_t addr, uint8_t *data, uint16_t count)
+{
+	return false;
+}
+
+bool i2cWriteRegister(uint8_t addr, uint8_t reg, uint16_t value)
+{
+	return false;
+}
+
+void lcdClear(PROS_FILE *lcdPort)
+{
+}
+
+void lcdInit(PROS_FILE *lcdPort)
+{
+}
+
+void lcdPrint(PROS_FILE *lcdPort, unsigned char line, const char *formatString, ...)
+{
+}
+
+unsigned int lcdReadButtons(PROS_FILE *lcdPort)
+{
+	return 0;
+}
+
+void lcdSetBacklight(PROS_FILE *lcdPort, bool backlight)
+{
+}
+
+void lcdSetText(PROS_FILE *lcdPort, unsigned char line, const char *buffer)
+{
+}
+
+void lcdShutdown(PROS_FILE *lcdPort)
+{
+}
+
+void watchdogInit()
+{
+}
+
+void standaloneModeEnable()
+{
+}
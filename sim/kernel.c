@@ -0,0 +1,399 @@
+/** @file kernel.c
+ * @brief Simulated tasks, synchronization and virtual time
+ *
+ * Every task is a host thread, but a task only runs while it holds the baton. A task gives up
+ * the baton when it blocks, and the kernel hands it to the task with the earliest wake time
+ * (ties go to the higher priority, then to the task that has waited longest), advancing the
+ * virtual clock and stepping the plant model one millisecond at a time on the way.
+ */
+
+#include <limits.h>
+#include <pthread.h>
+
+#include "main.h"
+#include "sim.h"
+
+#define SIM_MAX_TASKS 64
+
+typedef struct {
+	pthread_cond_t cond;
+	TaskCode code;
+	void *param;
+	unsigned int priority;
+	unsigned int state;
+	// Virtual time in microseconds when the task may run again
+	unsigned long long wake;
+	// Sequence number of the task's last block, for round robin between equals
+	unsigned long order;
+	bool baton;
+	bool used;
+} SimTask;
+
+typedef struct {
+	void (*fn)(void);
+	unsigned long increment;
+} SimLoop;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static SimTask tasks[SIM_MAX_TASKS];
+static SimLoop loops[SIM_MAX_TASKS];
+static __thread SimTask *self;
+static unsigned long order;
+
+// Current virtual time and the time the plant has been stepped to, in microseconds
+static volatile unsigned long long now;
+static unsigned long long stepped;
+static unsigned long long endTime = ULLONG_MAX;
+
+static SimTask* simPickNext()
+{
+	SimTask *best = NULL;
+	int i;
+
+	for (i = 0; i < SIM_MAX_TASKS; i++)
+	{
+		SimTask *t = &tasks[i];
+		if (!t->used || t->state == TASK_DEAD || t->state == TASK_SUSPENDED)
+			continue;
+		if (best == NULL || t->wake < best->wake ||
+			(t->wake == best->wake && (t->priority > best->priority ||
+			(t->priority == best->priority && t->order < best->order))))
+			best = t;
+	}
+	return best;
+}
+
+// Hands the baton to the next task and, unless the calling task is dead, blocks until it gets
+// the baton back. Called with the lock held.
+static void simSchedule()
+{
+	SimTask *next = simPickNext();
+
+	if (next == NULL || next->wake > endTime)
+	{
+		pthread_mutex_unlock(&lock);
+		simFinish();
+	}
+	while (stepped + 1000 <= next->wake)
+	{
+		stepped += 1000;
+		now = stepped;
+		plantStep();
+	}
+	if (next->wake > now)
+		now = next->wake;
+	if (next == self)
+		return;
+
+	self->baton = false;
+	next->baton = true;
+	pthread_cond_signal(&next->cond);
+	if (self->state == TASK_DEAD)
+		return;
+	while (!self->baton)
+		pthread_cond_wait(&self->cond, &lock);
+}
+
+static void simBlockUntil(unsigned long long wake)
+{
+	pthread_mutex_lock(&lock);
+	self->wake = wake > now ? wake : now;
+	self->order = order++;
+	simSchedule();
+	pthread_mutex_unlock(&lock);
+}
+
+static void* simTrampoline(void *arg)
+{
+	SimTask *t = (SimTask*)arg;
+
+	pthread_mutex_lock(&lock);
+	self = t;
+	while (!t->baton)
+		pthread_cond_wait(&t->cond, &lock);
+	pthread_mutex_unlock(&lock);
+
+	t->code(t->param);
+
+	pthread_mutex_lock(&lock);
+	t->state = TASK_DEAD;
+	simSchedule();
+	pthread_mutex_unlock(&lock);
+	return NULL;
+}
+
+void simKernelInit()
+{
+	self = &tasks[0];
+	pthread_cond_init(&self->cond, NULL);
+	self->used = true;
+	self->baton = true;
+	self->state = TASK_RUNNABLE;
+	self->priority = SIM_HARNESS_PRIORITY;
+}
+
+void simSetEndTime(unsigned long ms)
+{
+	endTime = (unsigned long long)ms * 1000;
+}
+
+TaskHandle taskCreate(TaskCode taskCode, const unsigned int stackDepth, void *parameters,
+	const unsigned int priority)
+{
+	pthread_t thread;
+	pthread_attr_t attr;
+	SimTask *t = NULL;
+	int i;
+
+	pthread_mutex_lock(&lock);
+	for (i = 0; i < SIM_MAX_TASKS; i++)
+		if (!tasks[i].used)
+		{
+			t = &tasks[i];
+			break;
+		}
+	if (t == NULL)
+	{
+		pthread_mutex_unlock(&lock);
+		return NULL;
+	}
+	pthread_cond_init(&t->cond, NULL);
+	t->code = taskCode;
+	t->param = parameters;
+	t->priority = priority;
+	t->state = TASK_RUNNABLE;
+	t->wake = now;
+	t->order = order++;
+	t->baton = false;
+	t->used = true;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&thread, &attr, simTrampoline, t) != 0)
+	{
+		t->used = false;
+		t = NULL;
+	}
+	pthread_attr_destroy(&attr);
+	pthread_mutex_unlock(&lock);
+	return t;
+}
+
+void taskDelete(TaskHandle taskToDelete)
+{
+	SimTask *t = taskToDelete == NULL ? self : (SimTask*)taskToDelete;
+
+	pthread_mutex_lock(&lock);
+	t->state = TASK_DEAD;
+	if (t == self)
+	{
+		simSchedule();
+		pthread_mutex_unlock(&lock);
+		pthread_exit(NULL);
+	}
+	// Another task's thread stays parked on its condition forever; it is never handed the
+	// baton again
+	pthread_mutex_unlock(&lock);
+}
+
+void taskDelay(const unsigned long msToDelay)
+{
+	simBlockUntil(now + (unsigned long long)msToDelay * 1000);
+}
+
+void delay(const unsigned long time)
+{
+	taskDelay(time);
+}
+
+void wait(const unsigned long time)
+{
+	taskDelay(time);
+}
+
+void delayMicroseconds(const unsigned long us)
+{
+	simBlockUntil(now + us);
+}
+
+void taskDelayUntil(unsigned long *previousWakeTime, const unsigned long cycleTime)
+{
+	*previousWakeTime += cycleTime;
+	simBlockUntil((unsigned long long)*previousWakeTime * 1000);
+}
+
+void waitUntil(unsigned long *previousWakeTime, const unsigned long time)
+{
+	taskDelayUntil(previousWakeTime, time);
+}
+
+unsigned int taskGetCount()
+{
+	unsigned int count = 0;
+	int i;
+
+	for (i = 0; i < SIM_MAX_TASKS; i++)
+		if (tasks[i].used && tasks[i].state != TASK_DEAD)
+			count++;
+	return count;
+}
+
+unsigned int taskGetState(TaskHandle task)
+{
+	SimTask *t = task == NULL ? self : (SimTask*)task;
+
+	if (t == self)
+		return TASK_RUNNING;
+	if (t->state == TASK_RUNNABLE && t->wake > now)
+		return TASK_SLEEPING;
+	return t->state;
+}
+
+unsigned int taskPriorityGet(const TaskHandle task)
+{
+	return (task == NULL ? self : (SimTask*)task)->priority;
+}
+
+void taskPrioritySet(TaskHandle task, const unsigned int newPriority)
+{
+	(task == NULL ? self : (SimTask*)task)->priority = newPriority;
+}
+
+void taskSuspend(TaskHandle taskToSuspend)
+{
+	SimTask *t = taskToSuspend == NULL ? self : (SimTask*)taskToSuspend;
+
+	pthread_mutex_lock(&lock);
+	t->state = TASK_SUSPENDED;
+	if (t == self)
+		simSchedule();
+	pthread_mutex_unlock(&lock);
+}
+
+void taskResume(TaskHandle taskToResume)
+{
+	SimTask *t = (SimTask*)taskToResume;
+
+	pthread_mutex_lock(&lock);
+	if (t->state == TASK_SUSPENDED)
+	{
+		t->state = TASK_RUNNABLE;
+		if (t->wake < now)
+			t->wake = now;
+	}
+	pthread_mutex_unlock(&lock);
+}
+
+static void simRunLoop(void *param)
+{
+	SimLoop *loop = (SimLoop*)param;
+	unsigned long wakeTime = millis();
+
+	while (1)
+	{
+		loop->fn();
+		taskDelayUntil(&wakeTime, loop->increment);
+	}
+}
+
+TaskHandle taskRunLoop(void (*fn)(void), const unsigned long increment)
+{
+	static int next;
+	SimLoop *loop;
+
+	if (next >= SIM_MAX_TASKS)
+		return NULL;
+	loop = &loops[next++];
+	loop->fn = fn;
+	loop->increment = increment;
+	return taskCreate(simRunLoop, TASK_DEFAULT_STACK_SIZE, loop, TASK_PRIORITY_DEFAULT);
+}
+
+// Mutexes and semaphores are never contended while their holder runs, since only one task
+// runs at a time; a task that finds one taken polls it once per virtual millisecond.
+
+typedef struct {
+	void *owner;
+	int count;
+} SimLock;
+
+static bool simLockTake(SimLock *l, bool isMutex, unsigned long blockTime)
+{
+	unsigned long waited = 0;
+
+	while (1)
+	{
+		if (isMutex ? l->owner == NULL : l->count > 0)
+		{
+			if (isMutex)
+				l->owner = self;
+			else
+				l->count--;
+			return true;
+		}
+		if (blockTime != (unsigned long)-1 && waited >= blockTime)
+			return false;
+		taskDelay(1);
+		waited++;
+	}
+}
+
+Mutex mutexCreate()
+{
+	SimLock *l = (SimLock*)calloc(1, sizeof(SimLock));
+	return l;
+}
+
+bool mutexGive(Mutex mutex)
+{
+	SimLock *l = (SimLock*)mutex;
+
+	if (l->owner != self)
+		return false;
+	l->owner = NULL;
+	return true;
+}
+
+bool mutexTake(Mutex mutex, const unsigned long blockTime)
+{
+	return simLockTake((SimLock*)mutex, true, blockTime);
+}
+
+void mutexDelete(Mutex mutex)
+{
+	free(mutex);
+}
+
+Semaphore semaphoreCreate()
+{
+	SimLock *l = (SimLock*)calloc(1, sizeof(SimLock));
+	if (l != NULL)
+		l->count = 1;
+	return l;
+}
+
+bool semaphoreGive(Semaphore semaphore)
+{
+	((SimLock*)semaphore)->count = 1;
+	return true;
+}
+
+bool semaphoreTake(Semaphore semaphore, const unsigned long blockTime)
+{
+	return simLockTake((SimLock*)semaphore, false, blockTime);
+}
+
+void semaphoreDelete(Semaphore semaphore)
+{
+	free(semaphore);
+}
+
+unsigned long millis()
+{
+	return (unsigned long)(now / 1000);
+}
+
+unsigned long micros()
+{
+	return (unsigned long)now;
+}
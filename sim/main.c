@@ -0,0 +1,445 @@
+/** @file main.c
+ * @brief Host simulation harness for the robot program
+ *
+ * Runs initializeIO() and initialize(), then operatorControl() (or autonomous() with -a) on the
+ * virtual clock, applying the timed inputs from an optional scenario file (see
+ * sim/host/scenario.h). At the end of the run it prints the loop timing, output stage and
+ * sorter statistics. The exit status is 1 if an expect event in the scenario failed.
+ *
+ * Usage: robot-sim [-t ms] [-a] [-o capture.bin] [-f flashdir] [scenario]
+ */
+
+#include <string.h>
+
+#include "main.h"
+#include "sim.h"
+#include "host/host.h"
+#include "host/scenario.h"
+
+#define SIM_MAX_EVENTS 4096
+#define SIM_MAX_PULSES 16
+// Widths of the Arduino pulses the "ball" scenario event generates
+#define SIM_FRIENDLY_PULSE_MS 1
+#define SIM_ENEMY_PULSE_MS 3
+
+static ScenarioEvent events[SIM_MAX_EVENTS];
+// Times at which an Arduino pulse in progress ends
+static unsigned long pulseEnds[SIM_MAX_PULSES];
+static int pulses;
+
+static unsigned long endMs = 10000;
+static unsigned long long wallStart;
+static TaskHandle modeTask;
+
+// A value scenarios can check with expect events
+typedef struct {
+	const char *name;
+	long (*get)(int port);
+} SimMetric;
+
+// Checks made by expect events, and those that held
+static unsigned int expects;
+static unsigned int expectsChecked;
+static unsigned int expectsHeld;
+
+static long simMotor(int port)
+{
+	return motorGet(port);
+}
+
+static long simLifterCutoffs(int port)
+{
+	return lifterGetStats()->cutoffs;
+}
+
+static long simLifterLatency(int port)
+{
+	return lifterGetStats()->maxStopLatency;
+}
+
+static long simLifterOverdrive(int port)
+{
+	return plantLifterOverdrive();
+}
+
+static long simCurrentTotal(int port)
+{
+	return (long)(plantPeakCurrent(false) * 1000);
+}
+
+static long simCurrentDrive(int port)
+{
+	return (long)(plantPeakCurrent(true) * 1000);
+}
+
+static long simPowerShaved(int port)
+{
+	return powerGetStats()->shavedUpdates;
+}
+
+static long simSorterSorted(int port)
+{
+	return sorterGetStats()->sorted;
+}
+
+static long simRecorderFrames(int port)
+{
+	return recorderGetStats()->frames;
+}
+
+static long simRecorderBytes(int port)
+{
+	return recorderGetStats()->bytes;
+}
+
+static long simRecorderReplayed(int port)
+{
+	return recorderGetStats()->replayed;
+}
+
+static long simRecorderError(int port)
+{
+	return recorderGetStats()->maxReplayError;
+}
+
+static const SimMetric simMetrics[] = {
+	// motorSet() value on a port
+	{ "motor", simMotor },
+	// End stop cutoffs, their longest latency in us, and ms driven into a closed stop
+	{ "lifter.cutoffs", simLifterCutoffs },
+	{ "lifter.latency", simLifterLatency },
+	{ "lifter.overdrive", simLifterOverdrive },
+	// Peak motor current in mA, of all motors and of the drive
+	{ "current.total", simCurrentTotal },
+	{ "current.drive", simCurrentDrive },
+	// Power manager updates that shaved outputs
+	{ "power.shaved", simPowerShaved },
+	// Balls sorted
+	{ "sorter.sorted", simSorterSorted },
+	// Frames and encoded bytes recorded, frames replayed, and the worst replay error in us
+	{ "recorder.frames", simRecorderFrames },
+	{ "recorder.bytes", simRecorderBytes },
+	{ "recorder.replayed", simRecorderReplayed },
+	{ "recorder.error", simRecorderError },
+};
+
+static const SimMetric* simFindMetric(const char *name)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(simMetrics) / sizeof(simMetrics[0]); i++)
+		if (strcmp(name, simMetrics[i].name) == 0)
+			return &simMetrics[i];
+	return NULL;
+}
+
+static void simError(const char *format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	hostVprintf(HOST_STDERR, format, args);
+	va_end(args);
+}
+
+static void simExpect(const ScenarioEvent *e)
+{
+	long value = simFindMetric(e->text)->get(e->a);
+	bool held = false;
+
+	switch (e->c)
+	{
+	case SCENARIO_LT:
+		held = value < e->b;
+		break;
+	case SCENARIO_LE:
+		held = value <= e->b;
+		break;
+	case SCENARIO_EQ:
+		held = value == e->b;
+		break;
+	case SCENARIO_NE:
+		held = value != e->b;
+		break;
+	case SCENARIO_GE:
+		held = value >= e->b;
+		break;
+	case SCENARIO_GT:
+		held = value > e->b;
+		break;
+	}
+	expectsChecked++;
+	if (held)
+		expectsHeld++;
+	else if (e->a != 0)
+		simError("%lu ms: expected %s %d %s %d, got %ld\n", e->time, e->text, e->a,
+			scenarioComparisonName(e->c), e->b, value);
+	else
+		simError("%lu ms: expected %s %s %d, got %ld\n", e->time, e->text,
+			scenarioComparisonName(e->c), e->b, value);
+}
+
+static void simOperatorControl(void *ignore)
+{
+	operatorControl();
+}
+
+static void simAutonomous(void *ignore)
+{
+	autonomous();
+}
+
+// Starts the task for a competition mode, killing the previous one as the kernel would
+static void simStartMode(bool isAuto)
+{
+	if (modeTask != NULL)
+		taskDelete(modeTask);
+	simSetAutonomous(isAuto);
+	modeTask = taskCreate(isAuto ? simAutonomous : simOperatorControl,
+		TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
+}
+
+static void simApply(const ScenarioEvent *e)
+{
+	switch (e->kind)
+	{
+	case SCENARIO_AXIS:
+		simJoystickAxis(e->a, e->b);
+		break;
+	case SCENARIO_BUTTON:
+		simJoystickButton(e->a, e->b, e->c);
+		break;
+	case SCENARIO_PIN:
+		simDigitalInput(e->a, e->b);
+		break;
+	case SCENARIO_BALL:
+		if (pulses < SIM_MAX_PULSES)
+		{
+			simDigitalInput(ARDUINO_SENS_OUT, HIGH);
+			pulseEnds[pulses++] = e->time + (e->a ? SIM_ENEMY_PULSE_MS : SIM_FRIENDLY_PULSE_MS);
+		}
+		break;
+	case SCENARIO_AUTO:
+		simStartMode(e->a != 0);
+		break;
+	case SCENARIO_SERIAL:
+		simSerialInput(e->text);
+		break;
+	case SCENARIO_BATTERY:
+		simSetBattery(e->a, e->b);
+		break;
+	case SCENARIO_EXPECT:
+		simExpect(e);
+		break;
+	case SCENARIO_SLEW:
+		motorsSetSlew(e->a, e->b, e->c);
+		break;
+	}
+}
+
+static void simEndPulses(unsigned long ms)
+{
+	int i = 0;
+
+	while (i < pulses)
+	{
+		if (pulseEnds[i] <= ms)
+		{
+			simDigitalInput(ARDUINO_SENS_OUT, LOW);
+			pulseEnds[i] = pulseEnds[--pulses];
+		}
+		else
+			i++;
+	}
+}
+
+static void simReportLoop(const char *name, const LoopTimer *timer)
+{
+	simReport("%s loop: %lu cycles, period %lu-%lu us (jitter %lu us), exec mean %lu us "
+		"max %lu us, cpu %lu.%lu%%, %lu overruns\n", name, timer->cycles, timer->minPeriod,
+		timer->maxPeriod, loopTimerJitter(timer), loopTimerMeanExec(timer), timer->maxExec,
+		loopTimerCpuShare(timer) / 10, loopTimerCpuShare(timer) % 10, timer->overruns);
+}
+
+static void simReportProfile()
+{
+#if PROF_ENABLED
+	static const char *names[PROF_SECTIONS] = {
+		"drive", "bindings", "mechanisms", "telemetry", "vm", "coroutines"
+	};
+	unsigned char i, j;
+
+	for (i = 0; i < PROF_SECTIONS; i++)
+	{
+		const ProfSection *s = profGet(i);
+
+		if (s->count == 0)
+			continue;
+		simReport("profile %-10s %6lu samples, %lu-%lu us, mean %lu us, buckets", names[i],
+			s->count, s->min, s->max, (unsigned long)(s->total / s->count));
+		for (j = 0; j < PROF_BUCKETS; j++)
+			simReport(" %lu", s->buckets[j]);
+		simReport("\n");
+	}
+#endif
+}
+
+void simFinish()
+{
+	unsigned long long wall = hostWallMicros() - wallStart;
+	const MotorStats *motorStats = motorsGetStats();
+	const SorterStats *sorterStats = sorterGetStats();
+	const LifterStats *lifterStats = lifterGetStats();
+	const PowerStats *powerStats = powerGetStats();
+	const TrajectoryStats *trajectoryStats = trajectoryGetStats();
+	const RecorderStats *recorderStats = recorderGetStats();
+	const VmStats *vmStats = vmGetStats();
+	const CoroutineStats *coroutineStats = coroutinesGetStats();
+
+	simReport("simulated %lu ms in %.1f ms of host time (%.0fx real time)\n", endMs,
+		wall / 1000.0, wall > 0 ? endMs * 1000.0 / wall : 0.0);
+	simReportLoop("drive", &driveTimer);
+	simReportLoop("mechanism", &mechanismTimer);
+	simReportLoop("telemetry", &telemetryTimer);
+	simReport("motor stage: %lu flushes, %lu writes (%lu slew limited, %lu power limited), "
+		"%lu redundant writes avoided, %lu lock timeouts\n", motorStats->flushes,
+		motorStats->writes, motorStats->slewLimited, motorStats->powerLimited,
+		motorStats->writesAvoided, motorStats->lockTimeouts);
+	simReport("power: main min %u mV, demand peak %lu mA, %lu updates shaved\n",
+		powerStats->minMainMv, powerStats->peakDemandMa, powerStats->shavedUpdates);
+	simReport("motor current: peak %.1f A total, %.1f A drive\n", plantPeakCurrent(false),
+		plantPeakCurrent(true));
+	simReport("sorter: %lu sorted, %lu dropped, peak depth %u, latency mean %lu us max %lu us, "
+		"settle max %lu ms, %lu timeouts\n", sorterStats->sorted, sorterStats->dropped,
+		sorterStats->maxDepth, sorterStats->sorted ?
+		(unsigned long)(sorterStats->totalLatency / sorterStats->sorted) : 0,
+		sorterStats->maxLatency, sorterStats->maxSettle, sorterStats->timeouts);
+	simReport("lifter: %lu end stop cutoffs, stop latency max %lu us, polling would have added "
+		"up to %lu us; motor drove into a closed stop for %lu ms\n", lifterStats->cutoffs,
+		lifterStats->maxStopLatency, lifterStats->maxPollDelay, plantLifterOverdrive());
+	if (trajectoryStats->steps > 0)
+		simReport("trajectory: %lu steps, tracking error max %lu ticks, mean %lu ticks, "
+			"final %lu ticks, %lu IME failures\n", trajectoryStats->steps,
+			trajectoryStats->maxError, trajectoryStats->totalError / trajectoryStats->steps,
+			trajectoryStats->finalError, trajectoryStats->imeFailures);
+	if (recorderStats->frames > 0)
+		simReport("recorder: %lu frames (%lu gaps filled) in %lu bytes, %lu bytes/s, %.1f:1 "
+			"against raw frames; replayed %lu, timing error max %lu us\n",
+			recorderStats->frames, recorderStats->gaps, recorderStats->bytes,
+			recorderStats->bytes * 1000 / (recorderStats->frames * RECORDER_PERIOD_MS),
+			recorderStats->bytes ? recorderStats->frames * (INPUT_AXES + 2.0) /
+			recorderStats->bytes : 0.0, recorderStats->replayed, recorderStats->maxReplayError);
+	if (vmStats->ticks > 0)
+	{
+		unsigned char i;
+
+		simReport("vm: %lu instructions in %lu ticks, max %lu per tick, %lu sensor timeouts; "
+			"by opcode", vmStats->instructions, vmStats->ticks, vmStats->maxPerTick,
+			vmStats->timeouts);
+		for (i = 0; i < VM_OPCODES; i++)
+			simReport(" %lu", vmStats->executed[i]);
+		simReport("\n");
+	}
+	if (coroutineStats->ticks > 0)
+		simReport("coroutines: %lu resumes in %lu ticks, max %lu per tick; %u bytes of state "
+			"each against a %u byte task stack\n", coroutineStats->resumes, coroutineStats->ticks,
+			coroutineStats->maxPerTick, (unsigned int)sizeof(Coroutine),
+			(unsigned int)(TASK_DEFAULT_STACK_SIZE * 4));
+	simReport("telemetry: %lu records dropped; arduino: %lu balls dropped\n",
+		(unsigned long)telemetryOverflows(), arduinoDropped());
+	simReportProfile();
+	if (expects == 0)
+		exit(0);
+	simReport("expect: %u of %u checks held\n", expectsHeld, expects);
+	if (expectsChecked < expects)
+		simError("%u checks come after the end of the run\n", expects - expectsChecked);
+	exit(expectsHeld == expects ? 0 : 1);
+}
+
+static void simUsage()
+{
+	simReport("usage: robot-sim [-t ms] [-a] [-o capture.bin] [-f flashdir] [scenario]\n");
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	const char *scenario = NULL;
+	bool startAutonomous = false;
+	bool endGiven = false;
+	int count = 0;
+	int next = 0;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+		{
+			endMs = strtoul(argv[++i], NULL, 10);
+			endGiven = true;
+		}
+		else if (strcmp(argv[i], "-a") == 0)
+			startAutonomous = true;
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+		{
+			if (hostCaptureOpen(argv[++i]) != 0)
+			{
+				simReport("cannot open %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+			hostFlashDir(argv[++i]);
+		else if (argv[i][0] != '-' && scenario == NULL)
+			scenario = argv[i];
+		else
+			simUsage();
+	}
+	if (scenario != NULL && (count = scenarioLoad(scenario, events, SIM_MAX_EVENTS)) < 0)
+		return 1;
+	for (i = 0; i < count; i++)
+	{
+		if (events[i].kind == SCENARIO_END && !endGiven)
+		{
+			endMs = events[i].time;
+			endGiven = true;
+		}
+		else if (events[i].kind == SCENARIO_EXPECT)
+		{
+			if (simFindMetric(events[i].text) == NULL)
+			{
+				simError("%s: unknown metric %s\n", scenario, events[i].text);
+				return 1;
+			}
+			expects++;
+		}
+	}
+
+	wallStart = hostWallMicros();
+	simKernelInit();
+	simSetEndTime(endMs);
+	plantInit();
+
+	initializeIO();
+	initialize();
+	simStartMode(startAutonomous);
+
+	// Apply scenario events and Arduino pulse ends in time order, then idle until the end
+	while (1)
+	{
+		unsigned long wake = endMs + 1;
+
+		if (next < count && events[next].time < wake)
+			wake = events[next].time;
+		for (i = 0; i < pulses; i++)
+			if (pulseEnds[i] < wake)
+				wake = pulseEnds[i];
+		if (wake > millis())
+			delay(wake - millis());
+
+		simEndPulses(millis());
+		while (next < count && events[next].time <= millis())
+			simApply(&events[next++]);
+	}
+	return 0;
+}
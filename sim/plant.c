@@ -0,0 +1,149 @@
+/** @file plant.c
+ * @brief Simple physical model of the robot's mechanisms
+ *
+ * Each motor's speed follows the steady speed for its motorSet() value with a first-order lag. The
+ * steady speed follows the 393 curve in tools/motor393.csv, so the robot's linearization table has
+ * the same non-linearity to undo as on the real motors. The sorter paddle turns the sorter encoder,
+ * and the lifter travels between its two end stops, opening and closing the limit switches (LOW
+ * when pressed) as it reaches them. Each drive wheel's IME counts DRIVE_FREE_SPEED ticks per second
+ * at full speed; the wheels are unloaded. Time spent with the lifter motor driving into a closed
+ * end stop is counted.
+ *
+ * Each motor's current is modelled as its stall current times the difference between its
+ * steady and present speeds, both normalized, so a step in command draws a spike that
+ * decays as the motor comes up to speed. The peak of the total is recorded. The Arduino holds its
+ * output LOW between pulses. The numbers are rough estimates for 393 motors; they only need to
+ * make the control code behave plausibly.
+ */
+
+#include <math.h>
+
+#include "main.h"
+#include "sim.h"
+
+// Motor speed time constant in milliseconds
+#define PLANT_MOTOR_TAU_MS 60.0
+// Sorter encoder ticks per second at full power
+#define PLANT_SORTER_TICKS_PER_SEC 600.0
+// Lifter travel between end stops, and its speed at full power, in arbitrary units
+#define PLANT_LIFTER_TRAVEL 1000.0
+#define PLANT_LIFTER_UNITS_PER_SEC 700.0
+// Stall current of a 393 motor in amps
+#define PLANT_STALL_AMPS 4.8
+// imeGetVelocity() units per rpm for a 393 in torque gearing
+#define PLANT_IME_VELOCITY_PER_RPM 39.2
+
+static const unsigned char wheelPorts[DRIVE_WHEELS] = {
+	M_FRONT_LEFT, M_FRONT_RIGHT, M_BACK_LEFT, M_BACK_RIGHT
+};
+
+// Steady speed in percent against motorSet() value, as in tools/motor393.csv
+static const double responseCommand[] = {
+	0, 10, 15, 20, 25, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 127
+};
+static const double responseSpeed[] = {
+	0, 0, 6, 15, 24, 32, 47, 60, 70, 78, 84, 89, 93, 96, 98, 100
+};
+
+// Normalized speed (-1 to 1) of each motor; speed[0] is unused
+static double speed[MOTOR_PORTS + 1];
+static double sorterTicks;
+static double lifterPosition;
+static double wheelTicks[DRIVE_WHEELS];
+static unsigned long overdriveMs;
+static double peakCurrent;
+static double peakDriveCurrent;
+
+static void plantSwitches()
+{
+	simDigitalInput(LIFTER_SENS_MAX, lifterPosition >= PLANT_LIFTER_TRAVEL ? LOW : HIGH);
+	simDigitalInput(LIFTER_SENS_MIN, lifterPosition <= 0.0 ? LOW : HIGH);
+}
+
+// Normalized steady speed of a motor driven at a motorSet() value
+static double plantResponse(int value)
+{
+	double command = fabs(value);
+	unsigned int i;
+
+	for (i = 1; i < sizeof(responseCommand) / sizeof(responseCommand[0]) - 1 &&
+		command > responseCommand[i]; i++);
+	return copysign((responseSpeed[i - 1] + (responseSpeed[i] - responseSpeed[i - 1]) *
+		(command - responseCommand[i - 1]) / (responseCommand[i] - responseCommand[i - 1])) /
+		100.0, value);
+}
+
+void plantInit()
+{
+	int i;
+
+	for (i = 0; i <= MOTOR_PORTS; i++)
+		speed[i] = 0.0;
+	sorterTicks = 0.0;
+	lifterPosition = 0.0;
+	for (i = 0; i < DRIVE_WHEELS; i++)
+	{
+		wheelTicks[i] = 0.0;
+		simImeSet(i, 0, 0);
+	}
+	overdriveMs = 0;
+	peakCurrent = 0.0;
+	peakDriveCurrent = 0.0;
+	simEncoderSet(QUAD_TOP_PORT, 0);
+	simDigitalInput(ARDUINO_SENS_OUT, LOW);
+	plantSwitches();
+}
+
+void plantStep()
+{
+	double current = 0.0;
+	double driveCurrent = 0.0;
+	int i;
+
+	for (i = 1; i <= MOTOR_PORTS; i++)
+	{
+		double steady = plantResponse(motorGet(i));
+		double amps = fabs(steady - speed[i]) * PLANT_STALL_AMPS;
+
+		current += amps;
+		if (i == M_FRONT_LEFT || i == M_FRONT_RIGHT || i == M_BACK_LEFT || i == M_BACK_RIGHT)
+			driveCurrent += amps;
+		speed[i] += (steady - speed[i]) / PLANT_MOTOR_TAU_MS;
+	}
+	if (current > peakCurrent)
+		peakCurrent = current;
+	if (driveCurrent > peakDriveCurrent)
+		peakDriveCurrent = driveCurrent;
+
+	for (i = 0; i < DRIVE_WHEELS; i++)
+	{
+		double wheelSpeed = speed[wheelPorts[i]];
+
+		wheelTicks[i] += wheelSpeed * DRIVE_FREE_SPEED / 1000.0;
+		simImeSet(i, (int)floor(wheelTicks[i]),
+			(int)(wheelSpeed * DRIVE_FREE_SPEED * 60.0 / 627.2 * PLANT_IME_VELOCITY_PER_RPM));
+	}
+
+	sorterTicks += speed[SORTER] * PLANT_SORTER_TICKS_PER_SEC / 1000.0;
+	simEncoderSet(QUAD_TOP_PORT, (int)sorterTicks);
+
+	if ((motorGet(LIFTER) > 0 && lifterPosition >= PLANT_LIFTER_TRAVEL) ||
+		(motorGet(LIFTER) < 0 && lifterPosition <= 0.0))
+		overdriveMs++;
+	lifterPosition += speed[LIFTER] * PLANT_LIFTER_UNITS_PER_SEC / 1000.0;
+	if (lifterPosition > PLANT_LIFTER_TRAVEL)
+		lifterPosition = PLANT_LIFTER_TRAVEL;
+	else if (lifterPosition < 0.0)
+		lifterPosition = 0.0;
+	plantSwitches();
+}
+
+unsigned long plantLifterOverdrive()
+{
+	return overdriveMs;
+}
+
+double plantPeakCurrent(bool driveOnly)
+{
+	return driveOnly ? peakDriveCurrent : peakCurrent;
+}
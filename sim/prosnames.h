@@ -0,0 +1,38 @@
+/** @file prosnames.h
+ * @brief Renames PROS API functions that collide with the host C library
+ *
+ * Force-included (-include) ahead of every robot and simulator source in the host build so
+ * that, for example, the PROS fwrite() links against the simulator's simFwrite() rather than
+ * the C library's fwrite(). Sources under sim/host/ talk to the real C library and are built
+ * without this header.
+ */
+
+#ifndef PROSNAMES_H_
+#define PROSNAMES_H_
+
+#define fclose simFclose
+#define fcount simFcount
+#define fdelete simFdelete
+#define feof simFeof
+#define fflush simFflush
+#define fgetc simFgetc
+#define fgets simFgets
+#define fopen simFopen
+#define fprint simFprint
+#define fprintf simFprintf
+#define fputc simFputc
+#define fputs simFputs
+#define fread simFread
+#define fseek simFseek
+#define ftell simFtell
+#define fwrite simFwrite
+#define getchar simGetchar
+#define print simPrint
+#define printf simPrintf
+#define putchar simPutchar
+#define puts simPuts
+#define snprintf simSnprintf
+#define sprintf simSprintf
+#define wait simWait
+
+#endif
@@ -0,0 +1,117 @@
+/** @file sim.h
+ * @brief Host simulation of the PROS API
+ *
+ * The simulator implements the API.h surface on a Linux host so the robot program can run,
+ * be measured and be tested off the robot. Time is virtual: it only advances when every task
+ * is blocked in delay(), taskDelayUntil() or similar, at which point the clock jumps straight
+ * to the earliest wake time. Each PROS task runs on its own thread, but only one thread runs
+ * at a time, so a simulation is deterministic and runs much faster than real time.
+ *
+ * These functions let the harness (sim/main.c) and the plant model (sim/plant.c) drive inputs
+ * and observe outputs.
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <API.h>
+
+/**
+ * Priority of the harness task. Above every robot task so inputs that change at a given time
+ * are applied before the robot reads them.
+ */
+#define SIM_HARNESS_PRIORITY TASK_MAX_PRIORITIES
+
+// Kernel (sim/kernel.c)
+
+/**
+ * Turns the calling thread into the first simulated task. Call once before any other API.
+ */
+void simKernelInit();
+/**
+ * Sets the virtual time at which the simulation ends and simFinish() is called.
+ *
+ * @param ms the end time in milliseconds
+ */
+void simSetEndTime(unsigned long ms);
+/**
+ * Ends the simulation. Provided by the harness; called by the kernel when the end time is
+ * reached or no task can ever run again. Must not return.
+ */
+void simFinish();
+
+// Devices (sim/io.c)
+
+/**
+ * Sets a joystick 1 axis.
+ */
+void simJoystickAxis(unsigned char axis, int value);
+/**
+ * Presses or releases a joystick 1 button.
+ */
+void simJoystickButton(unsigned char group, unsigned char button, bool pressed);
+/**
+ * Drives a digital input to a level, firing any interrupt registered for that edge.
+ */
+void simDigitalInput(unsigned char pin, bool level);
+/**
+ * Sets the raw count of the quadrature encoder whose top wire is on a given port.
+ */
+void simEncoderSet(unsigned char portTop, int count);
+/**
+ * Sets the raw count and velocity (as imeGetVelocity() reports it) of an IME.
+ */
+void simImeSet(unsigned char address, int count, int velocity);
+/**
+ * Sets the value returned by analogRead() for a channel.
+ */
+void simAnalogInput(unsigned char channel, int value);
+/**
+ * Sets the value returned by isAutonomous().
+ */
+void simSetAutonomous(bool autonomous);
+/**
+ * Sets the main and backup battery voltages in millivolts.
+ */
+void simSetBattery(unsigned int mainMv, unsigned int backupMv);
+/**
+ * Gets the number of motorSet()/motorStop() calls made on a port.
+ */
+unsigned long simMotorWrites(unsigned char channel);
+
+// Serial ports and output capture (sim/stdio.c)
+
+/**
+ * Queues text to be read from the robot's stdin. Text that does not fit is dropped.
+ */
+void simSerialInput(const char *text);
+/**
+ * Prints a report line to the host's standard output.
+ */
+int simReport(const char *format, ...);
+
+// Robot plant model (sim/plant.c)
+
+/**
+ * Puts the mechanisms in their starting positions.
+ */
+void plantInit();
+/**
+ * Advances the mechanisms by one millisecond using the current motor outputs.
+ */
+void plantStep();
+/**
+ * Gets the time the lifter motor spent driving into a closed end stop.
+ *
+ * @return the time in milliseconds
+ */
+unsigned long plantLifterOverdrive();
+/**
+ * Gets the highest total current the motors drew at any step.
+ *
+ * @param driveOnly true to count only the four drive motors
+ * @return the current in amps
+ */
+double plantPeakCurrent(bool driveOnly);
+
+#endif
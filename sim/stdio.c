@@ -0,0 +1,239 @@
+/** @file stdio.c
+ * @brief Simulated serial ports and flash file system
+ *
+ * Everything the robot writes to stdout is sent to the capture file, if one was opened, so a
+ * telemetry stream can be fed to tools/teldecode. stdin reads the text queued by
+ * simSerialInput(). uart1, uart2 and the LCD discard output and never have input. Flash files
+ * map to files in a host directory.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "main.h"
+#include "sim.h"
+#include "host/host.h"
+
+// Streams 1-3 are the serial ports; flash file handles from the host are offset past them
+#define SIM_FILE_BASE 3
+// Size of the stdin receive buffer, matching the kernel's serial buffers
+#define SIM_SERIAL_BUFFER 64
+
+static char serialIn[SIM_SERIAL_BUFFER];
+static unsigned int serialHead;
+static unsigned int serialTail;
+
+static int simFileHandle(PROS_FILE *stream)
+{
+	intptr_t id = (intptr_t)stream;
+	return id > SIM_FILE_BASE ? (int)(id - SIM_FILE_BASE) : 0;
+}
+
+void simSerialInput(const char *text)
+{
+	while (*text != '\0' && serialHead - serialTail < SIM_SERIAL_BUFFER)
+		serialIn[serialHead++ % SIM_SERIAL_BUFFER] = *text++;
+}
+
+void usartInit(PROS_FILE *usart, unsigned int baud, unsigned int flags)
+{
+}
+
+void usartShutdown(PROS_FILE *usart)
+{
+}
+
+PROS_FILE * fopen(const char *file, const char *mode)
+{
+	int handle = hostFileOpen(file, mode);
+	return handle < 0 ? NULL : (PROS_FILE*)(intptr_t)(handle + SIM_FILE_BASE);
+}
+
+void fclose(PROS_FILE *stream)
+{
+	hostFileClose(simFileHandle(stream));
+}
+
+int fdelete(const char *file)
+{
+	return hostFileDelete(file);
+}
+
+size_t fwrite(const void *ptr, size_t size, size_t count, PROS_FILE *stream)
+{
+	int handle = simFileHandle(stream);
+
+	if (handle > 0)
+		return hostFileWrite(handle, ptr, size * count) / (size ? size : 1);
+	if (stream == stdout)
+		hostCaptureWrite(ptr, size * count);
+	return count;
+}
+
+size_t fread(void *ptr, size_t size, size_t count, PROS_FILE *stream)
+{
+	int handle = simFileHandle(stream);
+
+	if (handle > 0 && size > 0)
+		return hostFileRead(handle, ptr, size * count) / size;
+	return 0;
+}
+
+int fgetc(PROS_FILE *stream)
+{
+	int handle = simFileHandle(stream);
+
+	if (handle > 0)
+		return hostFileGetc(handle);
+	if (stream == stdin && serialTail != serialHead)
+		return (unsigned char)serialIn[serialTail++ % SIM_SERIAL_BUFFER];
+	return EOF;
+}
+
+char* fgets(char *str, int num, PROS_FILE *stream)
+{
+	int i = 0;
+	int c;
+
+	while (i < num - 1 && (c = fgetc(stream)) != EOF)
+	{
+		str[i++] = (char)c;
+		if (c == '\n')
+			break;
+	}
+	if (i == 0)
+		return NULL;
+	str[i] = '\0';
+	return str;
+}
+
+int feof(PROS_FILE *stream)
+{
+	int handle = simFileHandle(stream);
+	return handle > 0 ? hostFileEof(handle) : 0;
+}
+
+int fcount(PROS_FILE *stream)
+{
+	return stream == stdin ? (int)(serialHead - serialTail) : 0;
+}
+
+int fflush(PROS_FILE *stream)
+{
+	return 0;
+}
+
+int fseek(PROS_FILE *stream, long int offset, int origin)
+{
+	return hostFileSeek(simFileHandle(stream), offset, origin);
+}
+
+long int ftell(PROS_FILE *stream)
+{
+	return hostFileTell(simFileHandle(stream));
+}
+
+int fputc(int value, PROS_FILE *stream)
+{
+	unsigned char c = (unsigned char)value;
+
+	fwrite(&c, 1, 1, stream);
+	return c;
+}
+
+int fputs(const char *string, PROS_FILE *stream)
+{
+	fprint(string, stream);
+	fputc('\n', stream);
+	return (int)strlen(string);
+}
+
+void fprint(const char *string, PROS_FILE *stream)
+{
+	fwrite(string, 1, strlen(string), stream);
+}
+
+int getchar()
+{
+	return fgetc(stdin);
+}
+
+void print(const char *string)
+{
+	fprint(string, stdout);
+}
+
+int putchar(int value)
+{
+	return fputc(value, stdout);
+}
+
+int puts(const char *string)
+{
+	return fputs(string, stdout);
+}
+
+int fprintf(PROS_FILE *stream, const char *formatString, ...)
+{
+	char buffer[256];
+	va_list args;
+	int len;
+
+	va_start(args, formatString);
+	len = hostVsnprintf(buffer, sizeof(buffer), formatString, args);
+	va_end(args);
+	if (len > (int)sizeof(buffer) - 1)
+		len = sizeof(buffer) - 1;
+	if (len > 0)
+		fwrite(buffer, 1, len, stream);
+	return len;
+}
+
+int printf(const char *formatString, ...)
+{
+	char buffer[256];
+	va_list args;
+	int len;
+
+	va_start(args, formatString);
+	len = hostVsnprintf(buffer, sizeof(buffer), formatString, args);
+	va_end(args);
+	if (len > (int)sizeof(buffer) - 1)
+		len = sizeof(buffer) - 1;
+	if (len > 0)
+		fwrite(buffer, 1, len, stdout);
+	return len;
+}
+
+int snprintf(char *buffer, size_t limit, const char *formatString, ...)
+{
+	va_list args;
+	int len;
+
+	va_start(args, formatString);
+	len = hostVsnprintf(buffer, limit, formatString, args);
+	va_end(args);
+	return len;
+}
+
+int sprintf(char *buffer, const char *formatString, ...)
+{
+	va_list args;
+	int len;
+
+	va_start(args, formatString);
+	len = hostVsnprintf(buffer, (size_t)-1 >> 1, formatString, args);
+	va_end(args);
+	return len;
+}
+
+int simReport(const char *format, ...)
+{
+	va_list args;
+	int len;
+
+	va_start(args, format);
+	len = hostVprintf(HOST_STDOUT, format, args);
+	va_end(args);
+	return len;
+}
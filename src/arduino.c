@@ -0,0 +1,75 @@
+/** @file arduino.c
+ * @brief Interrupt-driven ball classification from the on-board Arduino
+ */
+
+#include "main.h"
+
+static ArduinoBall queue[ARDUINO_QUEUE_SIZE];
+// head is written only by the interrupt handler and tail only by the sorter's task
+static volatile unsigned long head;
+static volatile unsigned long tail;
+static volatile unsigned long dropped;
+// micros() at the rising edge of the pulse in progress, valid while pulseActive is set
+static unsigned long pulseStart;
+static bool pulseActive;
+
+void arduinoEdge(unsigned char pin)
+{
+	unsigned long now = micros();
+	unsigned long width;
+	unsigned long h;
+	ArduinoBall *ball;
+
+	if (digitalRead(pin))
+	{
+		pulseStart = now;
+		pulseActive = true;
+		return;
+	}
+	if (!pulseActive)
+		return;
+	pulseActive = false;
+	width = now - pulseStart;
+	if (width < ARDUINO_MIN_PULSE_US)
+		return;
+
+	h = head;
+	if (h - tail >= ARDUINO_QUEUE_SIZE)
+	{
+		dropped++;
+		return;
+	}
+	ball = &queue[h & (ARDUINO_QUEUE_SIZE - 1)];
+	ball->time = now;
+	ball->width = width;
+	ball->enemy = width >= ARDUINO_ENEMY_PULSE_US;
+	__sync_synchronize();
+	head = h + 1;
+}
+
+void arduinoInit()
+{
+	head = 0;
+	tail = 0;
+	dropped = 0;
+	pulseActive = false;
+	ioSetInterrupt(ARDUINO_SENS_OUT, INTERRUPT_EDGE_BOTH, arduinoEdge);
+}
+
+bool arduinoPoll(ArduinoBall *ball)
+{
+	unsigned long t = tail;
+
+	if (head == t)
+		return false;
+	__sync_synchronize();
+	*ball = queue[t & (ARDUINO_QUEUE_SIZE - 1)];
+	__sync_synchronize();
+	tail = t + 1;
+	return true;
+}
+
+unsigned long arduinoDropped()
+{
+	return dropped;
+}
@@ -8,6 +8,82 @@
  */
 
 #include "main.h"
+#include "paths.h"
+
+// Time the shooter gets to reach speed, and time the ramp and mixer feed it for
+#define SHOOTER_SPINUP_MS 1500
+#define FEED_MS 2000
+
+// Progress of the actions, for the ones that wait on others
+static bool pathDone;
+static bool shooterReady;
+static bool fed;
+
+// Follows the planned path
+static unsigned char drivePath(Coroutine *co, const SensorFrame *sens) {
+  CO_BEGIN(co);
+  trajectoryStart(&autoPath);
+  CO_WAIT_WHILE(co, trajectoryStep());
+  pathDone = true;
+  CO_END(co);
+}
+
+// Picks up balls until the robot reaches the shooting position
+static unsigned char runPickup(Coroutine *co, const SensorFrame *sens) {
+  CO_BEGIN(co);
+  motorsCommand(PICKUP, PICKUP_POWER);
+  CO_WAIT_UNTIL(co, pathDone);
+  motorsStop(PICKUP);
+  CO_END(co);
+}
+
+// Brings the shooter up to speed on the way
+static unsigned char spinShooter(Coroutine *co, const SensorFrame *sens) {
+  CO_BEGIN(co);
+  motorsCommand(SHOOTER, SHOOTER_POWER);
+  CO_DELAY(co, SHOOTER_SPINUP_MS);
+  shooterReady = true;
+  CO_END(co);
+}
+
+// Runs the sorter on the balls the Arduino classifies; returns true when it is idle
+static bool sortBalls(const SensorFrame *sens) {
+  ArduinoBall ball;
+
+  while (arduinoPoll(&ball))
+    sorterEnqueue(ball.enemy, ball.time);
+  sorterUpdate(sens);
+  return sorterIdle();
+}
+
+// Sorts until the balls have been fed to the shooter
+static unsigned char runSorter(Coroutine *co, const SensorFrame *sens) {
+  CO_BEGIN(co);
+  CO_WAIT_UNTIL(co, sortBalls(sens) && fed);
+  CO_END(co);
+}
+
+// Once in position with the shooter up to speed and the sorter done, feeds the shooter
+static unsigned char feedShooter(Coroutine *co, const SensorFrame *sens) {
+  CO_BEGIN(co);
+  CO_WAIT_UNTIL(co, pathDone && shooterReady && sorterIdle());
+  motorsCommand(RAMP, RAMP_POWER);
+  motorsCommand(MIXER, MIXER_POWER);
+  CO_DELAY(co, FEED_MS);
+  motorsStop(RAMP);
+  motorsStop(MIXER);
+  motorsStop(SHOOTER);
+  fed = true;
+  CO_END(co);
+}
+
+static Coroutine actions[] = {
+  { .resume = drivePath },
+  { .resume = runPickup },
+  { .resume = spinShooter },
+  { .resume = runSorter },
+  { .resume = feedShooter }
+};
 
 /*
  * Runs the user autonomous code. This function will be started in its own task with the default
@@ -24,4 +100,23 @@
  * so, the robot will await a switch to another mode or disable/enable cycle.
  */
 void autonomous() {
+  // A bytecode routine loaded at initialize() comes first. A routine recorded by the driver
+  // runs the operator control code on the recorded inputs; without either, follow the planned
+  // path while the actions above run alongside it
+  if (vmLoaded()) {
+    motorsInit();
+    powerInit();
+    vmRun();
+  } else if (recorderLoad(RECORDER_FILE)) {
+    inputSetSource(recorderReplay);
+    operatorControl();
+  } else {
+    motorsInit();
+    powerInit();
+    sorterInit();
+    pathDone = false;
+    shooterReady = false;
+    fed = false;
+    coroutinesRun(actions, sizeof(actions) / sizeof(actions[0]));
+  }
 }
@@ -0,0 +1,35 @@
+/** @file bindings.c
+ * @brief Table-driven mapping of button edges to mechanism events
+ */
+
+#include "main.h"
+
+static const BindingTable *current;
+
+void bindingsSelect(const BindingTable *table)
+{
+	current = table;
+}
+
+void bindingsUpdate(const Buttons *buttons)
+{
+	unsigned short edges[2];
+	unsigned long now;
+	unsigned char i;
+
+	if (current == NULL)
+		return;
+	edges[BIND_PRESS] = buttons->pressed;
+	edges[BIND_RELEASE] = buttons->released;
+	// Nothing changed, which is most cycles
+	if ((edges[BIND_PRESS] | edges[BIND_RELEASE]) == 0)
+		return;
+	now = micros();
+	for (i = 0; i < current->count; i++)
+	{
+		const Binding *b = &current->entries[i];
+
+		if (edges[b->edge] & b->button)
+			fsmPost(b->machine, b->event, (long)now);
+	}
+}
@@ -0,0 +1,63 @@
+/** @file buttons.c
+ * @brief Debounced button edges computed from InputFrame bitmasks
+ */
+
+#include "main.h"
+
+void buttonsInit(Buttons *buttons)
+{
+	unsigned char i;
+
+	buttons->held = 0;
+	buttons->pressed = 0;
+	buttons->released = 0;
+	buttons->toggled = 0;
+	buttons->locked = 0;
+	for (i = 0; i < BUTTONS_BITS; i++)
+	{
+		buttons->changeTime[i] = 0;
+		buttons->window[i] = BUTTONS_DEBOUNCE_MS;
+	}
+}
+
+void buttonsSetDebounce(Buttons *buttons, unsigned short mask, unsigned short windowMs)
+{
+	unsigned char i;
+
+	for (i = 0; i < BUTTONS_BITS; i++)
+		if (mask & (1 << i))
+			buttons->window[i] = windowMs;
+}
+
+void buttonsUpdate(Buttons *buttons, const InputFrame *frame)
+{
+	unsigned long now = frame->time;
+	unsigned short bits;
+	unsigned short accept;
+
+	// Release the buttons whose window has run out; only locked bits are visited
+	bits = buttons->locked;
+	while (bits)
+	{
+		unsigned char i = (unsigned char)__builtin_ctz(bits);
+		bits &= bits - 1;
+		if (now - buttons->changeTime[i] >= buttons->window[i])
+			buttons->locked &= ~(1 << i);
+	}
+
+	accept = (frame->buttons ^ buttons->held) & ~buttons->locked;
+	buttons->pressed = accept & frame->buttons;
+	buttons->released = accept & ~frame->buttons;
+	buttons->held ^= accept;
+	buttons->toggled ^= buttons->pressed;
+
+	// Start the window of every button that just changed
+	buttons->locked |= accept;
+	bits = accept;
+	while (bits)
+	{
+		unsigned char i = (unsigned char)__builtin_ctz(bits);
+		bits &= bits - 1;
+		buttons->changeTime[i] = now;
+	}
+}
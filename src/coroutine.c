@@ -0,0 +1,56 @@
+/** @file coroutine.c
+ * @brief Stackless coroutines for running autonomous actions side by side
+ */
+
+#include "main.h"
+
+static CoroutineStats stats;
+
+void coroutinesRun(Coroutine *coroutines, unsigned char count)
+{
+	LoopTimer timer;
+	SensorFrame sens;
+	unsigned char running = count;
+	unsigned char i;
+
+	for (i = 0; i < count; i++)
+		coroutines[i].line = 0;
+	stats.ticks = 0;
+	stats.resumes = 0;
+	stats.maxPerTick = 0;
+	loopTimerInit(&timer, COROUTINE_PERIOD_MS);
+	while (running > 0)
+	{
+		unsigned long resumed = 0;
+
+		loopTimerBegin(&timer);
+		sensorsSample(&sens);
+		PROF_BEGIN(PROF_COROUTINES);
+		for (i = 0; i < count; i++)
+		{
+			Coroutine *co = &coroutines[i];
+
+			if (co->line == CO_FINISHED)
+				continue;
+			resumed++;
+			if (co->resume(co, &sens) == CO_DONE)
+			{
+				co->line = CO_FINISHED;
+				running--;
+			}
+		}
+		PROF_END(PROF_COROUTINES);
+		powerUpdate();
+		motorsFlush();
+		stats.ticks++;
+		stats.resumes += resumed;
+		if (resumed > stats.maxPerTick)
+			stats.maxPerTick = resumed;
+		loopTimerWait(&timer);
+	}
+}
+
+const CoroutineStats* coroutinesGetStats()
+{
+	return &stats;
+}
@@ -0,0 +1,75 @@
+/** @file drive.c
+ * @brief Mecanum drive kinematics
+ */
+
+#include "main.h"
+
+static const unsigned char drivePorts[DRIVE_WHEELS] = {
+	M_FRONT_LEFT, M_FRONT_RIGHT, M_BACK_LEFT, M_BACK_RIGHT
+};
+// Number of IMEs found on the chain
+static unsigned int imeCount;
+
+void driveInit()
+{
+	int i;
+
+	for (i = 0; i < DRIVE_WHEELS; i++)
+		motorsSetSlew(drivePorts[i], DRIVE_SLEW_ACCEL, DRIVE_SLEW_DECEL);
+	imeCount = imeInitializeAll();
+}
+
+bool driveGetPosition(unsigned char wheel, int *ticks)
+{
+	if (wheel >= imeCount)
+		return false;
+	return imeGet(wheel, ticks);
+}
+
+void driveMix(int forward, int turn, int strafe, int wheels[DRIVE_WHEELS])
+{
+	int peak = 0;
+	int i;
+
+	wheels[DRIVE_FRONT_LEFT] = 0 - turn - forward + strafe;
+	wheels[DRIVE_FRONT_RIGHT] = 0 - turn + forward + strafe;
+	wheels[DRIVE_BACK_LEFT] = 0 - turn - forward - strafe;
+	wheels[DRIVE_BACK_RIGHT] = 0 - turn + forward - strafe;
+
+	for (i = 0; i < DRIVE_WHEELS; i++)
+		if (abs(wheels[i]) > peak)
+			peak = abs(wheels[i]);
+	if (peak <= DRIVE_MAX_POWER)
+		return;
+
+	// Scale every wheel by DRIVE_MAX_POWER / peak, rounding to nearest
+	for (i = 0; i < DRIVE_WHEELS; i++)
+	{
+		int scaled = abs(wheels[i]) * DRIVE_MAX_POWER + peak / 2;
+		wheels[i] = wheels[i] < 0 ? -(scaled / peak) : scaled / peak;
+	}
+}
+
+void driveMecanum(int forward, int turn, int strafe)
+{
+	int wheels[DRIVE_WHEELS];
+
+	driveMix(forward, turn, strafe, wheels);
+	driveWheels(wheels);
+}
+
+void driveWheels(const int wheels[DRIVE_WHEELS])
+{
+	int i;
+
+	for (i = 0; i < DRIVE_WHEELS; i++)
+		motorsCommand(drivePorts[i], wheels[i]);
+}
+
+void driveStop()
+{
+	int i;
+
+	for (i = 0; i < DRIVE_WHEELS; i++)
+		motorsStop(drivePorts[i]);
+}
@@ -0,0 +1,148 @@
+/** @file fsm.c
+ * @brief Table-driven finite state machines for the mechanisms
+ */
+
+#include "main.h"
+
+typedef struct {
+	const FsmMachine *machine;
+	unsigned char state;
+	// millis() when the current state was entered
+	unsigned long entered;
+} FsmInstance;
+
+typedef struct {
+	unsigned char id;
+	unsigned char event;
+	long arg;
+} FsmEvent;
+
+static FsmInstance instances[FSM_MAX_MACHINES];
+// Machines whose current state has a run action or a timeout
+static unsigned char activeMask;
+
+static FsmEvent queue[FSM_QUEUE_SIZE];
+static unsigned int head;
+static unsigned int tail;
+static unsigned long dropped;
+
+static void fsmEnter(unsigned char id, unsigned char state, long arg)
+{
+	FsmInstance *fsm = &instances[id];
+	const FsmState *s = &fsm->machine->states[state];
+
+	fsm->state = state;
+	fsm->entered = millis();
+	if (s->run != NULL || s->timeoutMs != 0)
+		activeMask |= 1 << id;
+	else
+		activeMask &= ~(1 << id);
+	if (s->entry != NULL)
+		s->entry(arg);
+}
+
+static void fsmDispatch(unsigned char id, unsigned char event, long arg)
+{
+	FsmInstance *fsm = &instances[id];
+	const FsmMachine *m = fsm->machine;
+	unsigned char i;
+
+	if (m == NULL)
+		return;
+	for (i = 0; i < m->transitionCount; i++)
+	{
+		const FsmTransition *t = &m->transitions[i];
+
+		if (t->event != event || (t->from != FSM_ANY && t->from != fsm->state))
+			continue;
+		if (t->to == FSM_STAY)
+		{
+			if (t->action != NULL)
+				t->action(arg);
+			return;
+		}
+		if (m->states[fsm->state].exit != NULL)
+			m->states[fsm->state].exit(arg);
+		if (t->action != NULL)
+			t->action(arg);
+		fsmEnter(id, t->to, arg);
+		return;
+	}
+}
+
+void fsmReset()
+{
+	unsigned char i;
+
+	for (i = 0; i < FSM_MAX_MACHINES; i++)
+		instances[i].machine = NULL;
+	activeMask = 0;
+	head = 0;
+	tail = 0;
+	dropped = 0;
+}
+
+void fsmStart(unsigned char id, const FsmMachine *machine)
+{
+	if (id >= FSM_MAX_MACHINES)
+		return;
+	instances[id].machine = machine;
+	fsmEnter(id, machine->initial, 0);
+}
+
+bool fsmPost(unsigned char id, unsigned char event, long arg)
+{
+	FsmEvent *e;
+
+	if (head - tail >= FSM_QUEUE_SIZE)
+	{
+		dropped++;
+		return false;
+	}
+	e = &queue[head & (FSM_QUEUE_SIZE - 1)];
+	e->id = id;
+	e->event = event;
+	e->arg = arg;
+	head++;
+	return true;
+}
+
+void fsmRun()
+{
+	unsigned long now = millis();
+	unsigned char bits;
+	unsigned int n;
+
+	for (n = 0; n < FSM_QUEUE_SIZE && tail != head; n++)
+	{
+		FsmEvent e = queue[tail & (FSM_QUEUE_SIZE - 1)];
+		tail++;
+		if (e.id < FSM_MAX_MACHINES)
+			fsmDispatch(e.id, e.event, e.arg);
+	}
+
+	// Only machines in an active state are visited
+	bits = activeMask;
+	while (bits)
+	{
+		unsigned char id = (unsigned char)__builtin_ctz(bits);
+		FsmInstance *fsm = &instances[id];
+		const FsmState *s = &fsm->machine->states[fsm->state];
+
+		bits &= bits - 1;
+		if (s->timeoutMs != 0 && now - fsm->entered >= s->timeoutMs)
+			fsmDispatch(id, FSM_TIMEOUT, 0);
+		else if (s->run != NULL)
+			s->run(0);
+	}
+}
+
+unsigned char fsmState(unsigned char id)
+{
+	return id < FSM_MAX_MACHINES ? instances[id].state : 0;
+}
+
+unsigned long fsmDropped()
+{
+	return dropped;
+}
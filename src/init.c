@@ -9,6 +9,8 @@
 
 #include "main.h"
 
+Encoder sorter;
+
 /*
  * Runs pre-initialization code. This function will be started in kernel mode one time while the
  * VEX Cortex is starting up. As the scheduler is still paused, most API functions will fail.
@@ -18,9 +20,9 @@
  * configure a UART port (usartOpen()) but cannot set up an LCD (lcdInit()).
  */
 void initializeIO() {
-  pinMode(3, INPUT);
-  pinMode(4, INPUT);
-  pinMode(7, INPUT);
+  pinMode(LIFTER_SENS_MAX, INPUT);
+  pinMode(LIFTER_SENS_MIN, INPUT);
+  pinMode(ARDUINO_SENS_OUT, INPUT);
   watchdogInit();
 }
 
@@ -39,4 +41,9 @@ void initializeIO() {
  */
 void initialize() {
   sorter = encoderInit(1, 2, 0);
+  arduinoInit();
+  lifterInit();
+  driveInit();
+  telemetryInit();
+  vmLoad(VM_FILE);
 }
@@ -0,0 +1,41 @@
+/** @file input.c
+ * @brief Per-cycle snapshot of the VEX Joystick
+ */
+
+#include "main.h"
+
+// Buttons that exist on the joystick; groups 5 and 6 only have up and down
+static const unsigned char buttonGroups[] = { 5, 5, 6, 6, 7, 7, 7, 7, 8, 8, 8, 8 };
+static const unsigned char buttonIds[] = {
+	JOY_DOWN, JOY_UP,
+	JOY_DOWN, JOY_UP,
+	JOY_DOWN, JOY_LEFT, JOY_UP, JOY_RIGHT,
+	JOY_DOWN, JOY_LEFT, JOY_UP, JOY_RIGHT
+};
+
+static void (*volatile source)(InputFrame *frame);
+
+void inputSetSource(void (*fn)(InputFrame *frame))
+{
+	source = fn;
+}
+
+void inputSample(InputFrame *frame, unsigned char joystick)
+{
+	void (*fn)(InputFrame *frame) = source;
+	unsigned short buttons = 0;
+	unsigned char i;
+
+	frame->time = millis();
+	if (fn != NULL)
+	{
+		fn(frame);
+		return;
+	}
+	for (i = 0; i < INPUT_AXES; i++)
+		frame->axis[i] = (signed char)joystickGetAnalog(joystick, i + 1);
+	for (i = 0; i < sizeof(buttonIds); i++)
+		if (joystickGetDigital(joystick, buttonGroups[i], buttonIds[i]))
+			buttons |= INPUT_BUTTON(buttonGroups[i], buttonIds[i]);
+	frame->buttons = buttons;
+}
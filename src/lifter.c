@@ -0,0 +1,99 @@
+/** @file lifter.c
+ * @brief Lifter with interrupt-driven end stops
+ */
+
+#include "main.h"
+
+// Latched switch states, written only by the interrupt handler after lifterInit()
+static volatile bool atMax;
+static volatile bool atMin;
+// micros() of the last cutoff the control loop has not yet seen
+static volatile unsigned long cutoffTime;
+static volatile bool cutoffPending;
+
+static LifterStats stats;
+
+void lifterEdge(unsigned char pin)
+{
+	unsigned long start = micros();
+	bool closed = digitalRead(pin) == LOW;
+	int into = pin == LIFTER_SENS_MAX ? 1 : -1;
+	unsigned long latency;
+
+	if (pin == LIFTER_SENS_MAX)
+		atMax = closed;
+	else
+		atMin = closed;
+	if (!closed)
+		return;
+
+	// Only cut the motor if it is, or is about to be, driving into this stop; a switch
+	// bouncing as the lifter leaves it must not stop it
+	if (motorGet(LIFTER) * into <= 0 && motorsGetCommand(LIFTER) * into <= 0)
+		return;
+	motorsHalt(LIFTER);
+	latency = micros() - start;
+
+	stats.cutoffs++;
+	stats.lastStopLatency = latency;
+	if (latency > stats.maxStopLatency)
+		stats.maxStopLatency = latency;
+	cutoffTime = start;
+	cutoffPending = true;
+}
+
+void lifterInit()
+{
+	stats.cutoffs = 0;
+	stats.lastStopLatency = 0;
+	stats.maxStopLatency = 0;
+	stats.lastPollDelay = 0;
+	stats.maxPollDelay = 0;
+	cutoffPending = false;
+	atMax = digitalRead(LIFTER_SENS_MAX) == LOW;
+	atMin = digitalRead(LIFTER_SENS_MIN) == LOW;
+	ioSetInterrupt(LIFTER_SENS_MAX, INTERRUPT_EDGE_BOTH, lifterEdge);
+	ioSetInterrupt(LIFTER_SENS_MIN, INTERRUPT_EDGE_BOTH, lifterEdge);
+}
+
+int lifterLimit(int power)
+{
+	if (cutoffPending)
+	{
+		unsigned long delay = micros() - cutoffTime;
+
+		cutoffPending = false;
+		stats.lastPollDelay = delay;
+		if (delay > stats.maxPollDelay)
+			stats.maxPollDelay = delay;
+	}
+	if ((power > 0 && atMax) || (power < 0 && atMin))
+		return 0;
+	return power;
+}
+
+void lifterDrive(int power)
+{
+	power = lifterLimit(power);
+	motorsCommand(LIFTER, power);
+	// If a stop closed between the check and the command, its handler has already halted the
+	// motor; make sure the stale command is not flushed back out
+	__sync_synchronize();
+	if (lifterLimit(power) != power)
+		motorsStop(LIFTER);
+}
+
+bool lifterAtMax()
+{
+	return atMax;
+}
+
+bool lifterAtMin()
+{
+	return atMin;
+}
+
+const LifterStats* lifterGetStats()
+{
+	return &stats;
+}
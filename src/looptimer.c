@@ -0,0 +1,86 @@
+/** @file looptimer.c
+ * @brief Fixed-rate loop scheduling with per-cycle timing statistics
+ */
+
+#include "main.h"
+
+void loopTimerInit(LoopTimer *timer, unsigned long periodMs)
+{
+	timer->periodMs = periodMs;
+	timer->wakeTime = millis();
+	timer->cycleStart = micros();
+	loopTimerResetStats(timer);
+}
+
+void loopTimerResetStats(LoopTimer *timer)
+{
+	timer->lastPeriod = 0;
+	timer->minPeriod = 0;
+	timer->maxPeriod = 0;
+	timer->lastExec = 0;
+	timer->maxExec = 0;
+	timer->totalExec = 0;
+	timer->cycles = 0;
+	timer->overruns = 0;
+}
+
+void loopTimerBegin(LoopTimer *timer)
+{
+	unsigned long now = micros();
+
+	// The first cycle after init/reset has no previous start to measure against
+	if (timer->cycles > 0)
+	{
+		unsigned long period = now - timer->cycleStart;
+		timer->lastPeriod = period;
+		if (timer->minPeriod == 0 || period < timer->minPeriod)
+			timer->minPeriod = period;
+		if (period > timer->maxPeriod)
+			timer->maxPeriod = period;
+	}
+	timer->cycleStart = now;
+}
+
+void loopTimerWait(LoopTimer *timer)
+{
+	unsigned long exec = micros() - timer->cycleStart;
+	unsigned long late;
+
+	timer->lastExec = exec;
+	if (exec > timer->maxExec)
+		timer->maxExec = exec;
+	timer->totalExec += exec;
+	timer->cycles++;
+
+	// If the next wake time has already passed, skip to the next slot still in the future so
+	// the loop keeps its phase instead of bursting through the missed cycles
+	late = millis() - timer->wakeTime;
+	if (late > timer->periodMs)
+	{
+		timer->overruns++;
+		timer->wakeTime += (late / timer->periodMs) * timer->periodMs;
+	}
+
+	taskDelayUntil(&timer->wakeTime, timer->periodMs);
+}
+
+unsigned long loopTimerJitter(const LoopTimer *timer)
+{
+	if (timer->cycles < 2)
+		return 0;
+	return timer->maxPeriod - timer->minPeriod;
+}
+
+unsigned long loopTimerMeanExec(const LoopTimer *timer)
+{
+	if (timer->cycles == 0)
+		return 0;
+	return (unsigned long)(timer->totalExec / timer->cycles);
+}
+
+unsigned long loopTimerCpuShare(const LoopTimer *timer)
+{
+	if (timer->cycles == 0 || timer->periodMs == 0)
+		return 0;
+	return (unsigned long)(timer->totalExec / timer->cycles / timer->periodMs);
+}
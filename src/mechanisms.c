@@ -0,0 +1,259 @@
+/** @file mechanisms.c
+ * @brief State machines for the pickup, shooter, ramp, lifter, sorter and mixer
+ */
+
+#include "main.h"
+
+// Sensor frame of the cycle being run, for the run actions
+static const SensorFrame *frame;
+
+// Pickup
+
+// The states record whether the pickup is toggled on and whether its hold button is held; it
+// runs while either is
+#define PICKUP_OFF 0
+#define PICKUP_ON 1
+#define PICKUP_HELD 2
+#define PICKUP_BOTH 3
+
+static void pickupStop(long arg)
+{
+	motorsStop(PICKUP);
+}
+
+static void pickupRun(long arg)
+{
+	motorsCommand(PICKUP, PICKUP_POWER);
+}
+
+static const FsmState pickupStates[] = {
+	[PICKUP_OFF] = { pickupStop, NULL, NULL, 0 },
+	[PICKUP_ON] = { pickupRun, NULL, NULL, 0 },
+	[PICKUP_HELD] = { pickupRun, NULL, NULL, 0 },
+	[PICKUP_BOTH] = { pickupRun, NULL, NULL, 0 },
+};
+static const FsmTransition pickupTransitions[] = {
+	{ PICKUP_OFF, PICKUP_TOGGLE, PICKUP_ON, NULL },
+	{ PICKUP_ON, PICKUP_TOGGLE, PICKUP_OFF, NULL },
+	{ PICKUP_HELD, PICKUP_TOGGLE, PICKUP_BOTH, NULL },
+	{ PICKUP_BOTH, PICKUP_TOGGLE, PICKUP_HELD, NULL },
+	{ PICKUP_OFF, PICKUP_HOLD, PICKUP_HELD, NULL },
+	{ PICKUP_ON, PICKUP_HOLD, PICKUP_BOTH, NULL },
+	{ PICKUP_HELD, PICKUP_RELEASE, PICKUP_OFF, NULL },
+	{ PICKUP_BOTH, PICKUP_RELEASE, PICKUP_ON, NULL },
+};
+static const FsmMachine pickupMachine = {
+	pickupStates, pickupTransitions, sizeof(pickupTransitions) / sizeof(FsmTransition), PICKUP_OFF
+};
+
+// Shooter
+
+#define SHOOTER_OFF 0
+#define SHOOTER_ON 1
+
+static void shooterStop(long arg)
+{
+	motorsStop(SHOOTER);
+}
+
+static void shooterSpin(long arg)
+{
+	motorsCommand(SHOOTER, SHOOTER_POWER);
+}
+
+static const FsmState shooterStates[] = {
+	[SHOOTER_OFF] = { shooterStop, NULL, NULL, 0 },
+	[SHOOTER_ON] = { shooterSpin, NULL, NULL, 0 },
+};
+static const FsmTransition shooterTransitions[] = {
+	{ SHOOTER_OFF, SHOOTER_START, SHOOTER_ON, NULL },
+	{ SHOOTER_ON, SHOOTER_STOP, SHOOTER_OFF, NULL },
+};
+static const FsmMachine shooterMachine = {
+	shooterStates, shooterTransitions, sizeof(shooterTransitions) / sizeof(FsmTransition),
+	SHOOTER_OFF
+};
+
+// Ramp
+
+// The states record which of the two buttons are held
+#define RAMP_IDLE 0
+#define RAMP_RAISING 1
+#define RAMP_LOWERING 2
+#define RAMP_BOTH 3
+
+static void rampStop(long arg)
+{
+	motorsStop(RAMP);
+}
+
+static void rampRaise(long arg)
+{
+	motorsCommand(RAMP, RAMP_POWER);
+}
+
+static void rampLower(long arg)
+{
+	motorsCommand(RAMP, -RAMP_POWER);
+}
+
+// With both buttons held, up wins
+static const FsmState rampStates[] = {
+	[RAMP_IDLE] = { rampStop, NULL, NULL, 0 },
+	[RAMP_RAISING] = { rampRaise, NULL, NULL, 0 },
+	[RAMP_LOWERING] = { rampLower, NULL, NULL, 0 },
+	[RAMP_BOTH] = { rampRaise, NULL, NULL, 0 },
+};
+static const FsmTransition rampTransitions[] = {
+	{ RAMP_IDLE, RAMP_UP, RAMP_RAISING, NULL },
+	{ RAMP_IDLE, RAMP_DOWN, RAMP_LOWERING, NULL },
+	{ RAMP_RAISING, RAMP_DOWN, RAMP_BOTH, NULL },
+	{ RAMP_LOWERING, RAMP_UP, RAMP_BOTH, NULL },
+	{ RAMP_RAISING, RAMP_UP_RELEASE, RAMP_IDLE, NULL },
+	{ RAMP_LOWERING, RAMP_DOWN_RELEASE, RAMP_IDLE, NULL },
+	{ RAMP_BOTH, RAMP_UP_RELEASE, RAMP_LOWERING, NULL },
+	{ RAMP_BOTH, RAMP_DOWN_RELEASE, RAMP_RAISING, NULL },
+};
+static const FsmMachine rampMachine = {
+	rampStates, rampTransitions, sizeof(rampTransitions) / sizeof(FsmTransition), RAMP_IDLE
+};
+
+// Lifter
+
+// As for the ramp, the states record which buttons are held until an end stop idles the lifter
+#define LIFTER_IDLE 0
+#define LIFTER_RAISING 1
+#define LIFTER_LOWERING 2
+#define LIFTER_BOTH 3
+
+static void lifterStop(long arg)
+{
+	lifterDrive(0);
+}
+
+// The end stops cut the motor from their interrupt handler; lifterDrive() keeps the run
+// actions from driving back into a closed one, and reaching one ends the move
+static void lifterRaise(long arg)
+{
+	lifterDrive(LIFTER_POWER);
+	if (lifterAtMax())
+		fsmPost(MECH_LIFTER, LIFTER_END_STOP, 0);
+}
+
+static void lifterLower(long arg)
+{
+	lifterDrive(-LIFTER_POWER);
+	if (lifterAtMin())
+		fsmPost(MECH_LIFTER, LIFTER_END_STOP, 0);
+}
+
+static const FsmState lifterStates[] = {
+	[LIFTER_IDLE] = { lifterStop, NULL, NULL, 0 },
+	[LIFTER_RAISING] = { lifterRaise, lifterRaise, NULL, 0 },
+	[LIFTER_LOWERING] = { lifterLower, lifterLower, NULL, 0 },
+	[LIFTER_BOTH] = { lifterRaise, lifterRaise, NULL, 0 },
+};
+static const FsmTransition lifterTransitions[] = {
+	{ LIFTER_IDLE, LIFTER_RAISE, LIFTER_RAISING, NULL },
+	{ LIFTER_IDLE, LIFTER_LOWER, LIFTER_LOWERING, NULL },
+	{ LIFTER_RAISING, LIFTER_LOWER, LIFTER_BOTH, NULL },
+	{ LIFTER_LOWERING, LIFTER_RAISE, LIFTER_BOTH, NULL },
+	{ LIFTER_RAISING, LIFTER_RAISE_RELEASE, LIFTER_IDLE, NULL },
+	{ LIFTER_LOWERING, LIFTER_LOWER_RELEASE, LIFTER_IDLE, NULL },
+	{ LIFTER_BOTH, LIFTER_RAISE_RELEASE, LIFTER_LOWERING, NULL },
+	{ LIFTER_BOTH, LIFTER_LOWER_RELEASE, LIFTER_RAISING, NULL },
+	{ FSM_ANY, LIFTER_END_STOP, LIFTER_IDLE, NULL },
+};
+static const FsmMachine lifterMachine = {
+	lifterStates, lifterTransitions, sizeof(lifterTransitions) / sizeof(FsmTransition),
+	LIFTER_IDLE
+};
+
+// Sorter
+
+#define SORTER_HOLDING 0
+#define SORTER_SORTING 1
+
+static void sorterFriendly(long arg)
+{
+	sorterEnqueue(false, (unsigned long)arg);
+}
+
+static void sorterEnemy(long arg)
+{
+	sorterEnqueue(true, (unsigned long)arg);
+}
+
+static void sorterHold(long arg)
+{
+	sorterUpdate(frame);
+}
+
+static void sorterSort(long arg)
+{
+	sorterUpdate(frame);
+	if (sorterIdle())
+		fsmPost(MECH_SORTER, SORTER_DONE, 0);
+}
+
+// The paddle is held on its target with feedback even when idle, so both states run
+static const FsmState sorterStates[] = {
+	[SORTER_HOLDING] = { NULL, sorterHold, NULL, 0 },
+	[SORTER_SORTING] = { NULL, sorterSort, NULL, 0 },
+};
+static const FsmTransition sorterTransitions[] = {
+	{ SORTER_HOLDING, SORTER_FRIENDLY, SORTER_SORTING, sorterFriendly },
+	{ SORTER_HOLDING, SORTER_ENEMY, SORTER_SORTING, sorterEnemy },
+	{ SORTER_SORTING, SORTER_FRIENDLY, FSM_STAY, sorterFriendly },
+	{ SORTER_SORTING, SORTER_ENEMY, FSM_STAY, sorterEnemy },
+	{ SORTER_SORTING, SORTER_DONE, SORTER_HOLDING, NULL },
+};
+static const FsmMachine sorterMachine = {
+	sorterStates, sorterTransitions, sizeof(sorterTransitions) / sizeof(FsmTransition),
+	SORTER_HOLDING
+};
+
+// Mixer
+
+#define MIXER_FORWARDS 0
+#define MIXER_BACKWARDS 1
+
+static void mixerForwards(long arg)
+{
+	motorsCommand(MIXER, MIXER_POWER);
+}
+
+static void mixerBackwards(long arg)
+{
+	motorsCommand(MIXER, -MIXER_POWER);
+}
+
+static const FsmState mixerStates[] = {
+	[MIXER_FORWARDS] = { mixerForwards, NULL, NULL, 0 },
+	[MIXER_BACKWARDS] = { mixerBackwards, NULL, NULL, 0 },
+};
+static const FsmTransition mixerTransitions[] = {
+	{ MIXER_FORWARDS, MIXER_REVERSE, MIXER_BACKWARDS, NULL },
+	{ MIXER_BACKWARDS, MIXER_FORWARD, MIXER_FORWARDS, NULL },
+};
+static const FsmMachine mixerMachine = {
+	mixerStates, mixerTransitions, sizeof(mixerTransitions) / sizeof(FsmTransition),
+	MIXER_FORWARDS
+};
+
+void mechanismsStart()
+{
+	fsmReset();
+	fsmStart(MECH_PICKUP, &pickupMachine);
+	fsmStart(MECH_SHOOTER, &shooterMachine);
+	fsmStart(MECH_RAMP, &rampMachine);
+	fsmStart(MECH_LIFTER, &lifterMachine);
+	fsmStart(MECH_SORTER, &sorterMachine);
+	fsmStart(MECH_MIXER, &mixerMachine);
+}
+
+void mechanismsUpdate(const SensorFrame *sens)
+{
+	frame = sens;
+	fsmRun();
+}
@@ -0,0 +1,19 @@
+/** @file motorlut.c
+ * @brief Motor linearization table
+ *
+ * Generated by tools/mklut.c from 17 measured points; do not edit. Run make lut
+ * after changing the measurements.
+ */
+
+#include "main.h"
+
+const unsigned char motorLinearTable[128] = {
+	  0,  11,  11,  12,  13,  13,  14,  15,  15,  16,  16,  16,  17,  17,  18,  18,
+	 19,  19,  20,  20,  20,  21,  21,  22,  22,  23,  23,  23,  24,  24,  25,  25,
+	 26,  26,  27,  27,  28,  28,  29,  29,  30,  30,  31,  31,  32,  32,  33,  33,
+	 34,  34,  35,  35,  36,  36,  37,  38,  38,  39,  39,  40,  40,  41,  41,  42,
+	 43,  43,  44,  44,  45,  46,  46,  47,  47,  48,  49,  49,  50,  51,  51,  52,
+	 53,  54,  55,  55,  56,  57,  58,  59,  59,  60,  61,  62,  63,  64,  65,  66,
+	 67,  68,  69,  70,  71,  73,  74,  75,  76,  78,  79,  81,  82,  84,  85,  87,
+	 88,  90,  92,  94,  96,  98, 100, 102, 105, 108, 110, 114, 118, 121, 124, 127
+};
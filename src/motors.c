@@ -0,0 +1,231 @@
+/** @file motors.c
+ * @brief Shadow-register motor output stage
+ */
+
+#include "main.h"
+
+// Value requested for each port this cycle; commanded[0] holds port 1
+static volatile signed char commanded[MOTOR_PORTS];
+// Value last handed to motorSet() for each port; also written by motorsHalt()
+static volatile signed char written[MOTOR_PORTS];
+// Ports commanded since the last flush, and ports that must be written regardless of value.
+// These are bytes rather than bitmasks so tasks commanding different ports never race on a
+// shared read-modify-write.
+static volatile unsigned char touched[MOTOR_PORTS];
+static unsigned char forced[MOTOR_PORTS];
+
+// Slew limits in output units per second (0 for none), and millis() when each port's output
+// last moved or reached its command
+static unsigned int slewAccel[MOTOR_PORTS];
+static unsigned int slewDecel[MOTOR_PORTS];
+static unsigned long slewTime[MOTOR_PORTS];
+// Percentage of the command each port is driven at, set by the power manager
+static volatile unsigned char scales[MOTOR_PORTS] = {
+	100, 100, 100, 100, 100, 100, 100, 100, 100, 100
+};
+
+static MotorStats stats;
+static Mutex flushLock;
+// Whether motorsSuspend() took flushLock, and so motorsResume() must give it back
+static bool suspendLocked;
+
+void motorsInit()
+{
+	unsigned char i;
+
+	for (i = 0; i < MOTOR_PORTS; i++)
+	{
+		commanded[i] = 0;
+		written[i] = 0;
+		touched[i] = 0;
+		forced[i] = 1;
+		slewTime[i] = millis();
+	}
+	if (flushLock == NULL)
+		flushLock = mutexCreate();
+	stats.flushes = 0;
+	stats.writes = 0;
+	stats.writesAvoided = 0;
+	stats.halts = 0;
+	stats.slewLimited = 0;
+	stats.powerLimited = 0;
+	stats.lockTimeouts = 0;
+}
+
+void motorsSetScale(unsigned char port, unsigned char percent)
+{
+	if (port < 1 || port > MOTOR_PORTS)
+		return;
+	scales[port - 1] = percent > 100 ? 100 : percent;
+}
+
+void motorsSetSlew(unsigned char port, unsigned int accel, unsigned int decel)
+{
+	if (port < 1 || port > MOTOR_PORTS)
+		return;
+	slewAccel[port - 1] = accel;
+	slewDecel[port - 1] = decel;
+}
+
+void motorsCommand(unsigned char port, int speed)
+{
+	if (port < 1 || port > MOTOR_PORTS)
+		return;
+	if (speed > 127)
+		speed = 127;
+	else if (speed < -127)
+		speed = -127;
+	commanded[port - 1] = (signed char)speed;
+	touched[port - 1] = 1;
+}
+
+void motorsStop(unsigned char port)
+{
+	motorsCommand(port, 0);
+}
+
+void motorsHalt(unsigned char port)
+{
+	if (port < 1 || port > MOTOR_PORTS)
+		return;
+	commanded[port - 1] = 0;
+	written[port - 1] = 0;
+	motorStop(port);
+	stats.halts++;
+}
+
+int motorsGetCommand(unsigned char port)
+{
+	if (port < 1 || port > MOTOR_PORTS)
+		return 0;
+	return commanded[port - 1];
+}
+
+// Limits the move of port i from its current output towards target to what its slew rates
+// allow in the time since it last moved
+static signed char motorsSlew(unsigned char i, int current, int target, unsigned long now)
+{
+	unsigned long elapsed = now - slewTime[i];
+	int step;
+
+	if (target == current)
+	{
+		slewTime[i] = now;
+		return (signed char)target;
+	}
+	// Moving away from zero accelerates; moving towards or through zero decelerates, and a
+	// reversal stops at zero before accelerating the other way
+	if ((current >= 0 && target > current) || (current <= 0 && target < current))
+	{
+		if (slewAccel[i] == 0)
+			step = 255;
+		else
+			step = (int)(slewAccel[i] * elapsed / 1000);
+	}
+	else
+	{
+		if (slewDecel[i] == 0)
+			step = 255;
+		else
+			step = (int)(slewDecel[i] * elapsed / 1000);
+		if ((current > 0 && target < 0) || (current < 0 && target > 0))
+			target = 0;
+	}
+	// Too soon to move by a whole unit; keep the time so the allowance accumulates
+	if (step == 0)
+		return (signed char)current;
+	slewTime[i] = now;
+	if (target > current)
+		return (signed char)(target - current > step ? current + step : target);
+	return (signed char)(current - target > step ? current - step : target);
+}
+
+// Raw motorSet() value for a linear speed
+static int motorsLinearize(signed char speed)
+{
+	return speed < 0 ? -motorLinearTable[-speed] : motorLinearTable[speed];
+}
+
+void motorsFlush()
+{
+	motorsFlushPorts(MOTOR_ALL_PORTS);
+}
+
+void motorsFlushPorts(unsigned short ports)
+{
+	unsigned long now = millis();
+	unsigned char i;
+
+	// The ports keep their last values; the next flush catches up on the commands
+	if (!mutexTake(flushLock, MOTOR_LOCK_TIMEOUT_MS))
+	{
+		stats.lockTimeouts++;
+		return;
+	}
+	for (i = 0; i < MOTOR_PORTS; i++)
+	{
+		signed char command = commanded[i];
+		signed char target;
+		signed char value;
+
+		if (!(ports & (1 << i)))
+			continue;
+		target = (signed char)(command * scales[i] / 100);
+		value = motorsSlew(i, written[i], target, now);
+		if (value != written[i] || forced[i])
+		{
+			// A motorsHalt() from an interrupt between reading the command and writing it
+			// would be undone by the write, so write again until the command holds still.
+			// Only a halt changes a port while its owner flushes it, and a halt skips the
+			// slew limits
+			while (1)
+			{
+				motorSet(i + 1, motorsLinearize(value));
+				written[i] = value;
+				if (commanded[i] == command)
+					break;
+				command = commanded[i];
+				target = command;
+				value = command;
+			}
+			stats.writes++;
+			if (target != command)
+				stats.powerLimited++;
+			if (value != target)
+				stats.slewLimited++;
+			telemetryPush(TELEM_MOTOR, i + 1, value);
+		}
+		else if (touched[i])
+			stats.writesAvoided++;
+		touched[i] = 0;
+		forced[i] = 0;
+	}
+	stats.flushes++;
+	mutexGive(flushLock);
+}
+
+void motorsSuspend()
+{
+	unsigned char i;
+
+	// Stop the motors even without the mutex: whoever holds it that long is not flushing
+	suspendLocked = mutexTake(flushLock, MOTOR_LOCK_TIMEOUT_MS);
+	for (i = 0; i < MOTOR_PORTS; i++)
+	{
+		motorStop(i + 1);
+		written[i] = 0;
+		forced[i] = 1;
+	}
+}
+
+void motorsResume()
+{
+	if (suspendLocked)
+		mutexGive(flushLock);
+	suspendLocked = false;
+}
+
+const MotorStats* motorsGetStats()
+{
+	return &stats;
+}
@@ -9,6 +9,7 @@
 
 #include "main.h"
 #include <stdlib.h>
+#include <string.h>
 
 /*
  * Runs the user operator control code. This function will be started in its own task with the
@@ -29,205 +30,272 @@
  */
 
 
-// Motor ports
-#define M_FRONT_LEFT 2
-#define M_FRONT_RIGHT 3
-#define M_BACK_LEFT 4
-#define M_BACK_RIGHT 5
-#define PICKUP 1
-#define SHOOTER 7
-#define RAMP 8
-#define SORTER 9
-#define LIFTER 6
-#define MIXER 10
-
-// Sensor (digital) ports
-#define LIFTER_SENS_MAX 3
-#define LIFTER_SENS_MIN 4
-#define ARDUINO_SENS_OUT 7
-
+// Deadzone of both sticks, and the response curves of the drive axes
 #define DEADZONE 20
-#define MIXER_SPEED 30
+#define FORWARD_CURVE SHAPE_EXPO
+#define STRAFE_CURVE SHAPE_EXPO
+#define TURN_CURVE SHAPE_EXPO
 
-int pickupIsActive = 0;
-int lifterAtMax = 0;
-int lifterAtMin = 0;
-int sorterFriendly = 0;
-int sorterEnemy = 0;
+// The pickup toggle ignores presses closer together than this
+#define PICKUP_DEBOUNCE_MS 100
 
-unsigned long pickupLastTime = 0;
-unsigned long sorterLastTime = 0;
-unsigned long debounceDelay = 100;
+// 7 down starts recording the driver's inputs for replay as the autonomous, off the field only
+#define RECORD_GROUP 7
+#define RECORD_BUTTON JOY_DOWN
 
-void moveRobot();
+// Mechanism controls
+static const Binding defaultBindings[] = {
+	// 7 right toggles the pickup on and off, 7 left runs it while held
+	BIND(7, JOY_RIGHT, BIND_PRESS, MECH_PICKUP, PICKUP_TOGGLE),
+	BIND(7, JOY_LEFT, BIND_PRESS, MECH_PICKUP, PICKUP_HOLD),
+	BIND(7, JOY_LEFT, BIND_RELEASE, MECH_PICKUP, PICKUP_RELEASE),
+	BIND(5, JOY_DOWN, BIND_PRESS, MECH_SHOOTER, SHOOTER_START),
+	BIND(5, JOY_UP, BIND_PRESS, MECH_SHOOTER, SHOOTER_STOP),
+	BIND(6, JOY_UP, BIND_PRESS, MECH_RAMP, RAMP_UP),
+	BIND(6, JOY_UP, BIND_RELEASE, MECH_RAMP, RAMP_UP_RELEASE),
+	BIND(6, JOY_DOWN, BIND_PRESS, MECH_RAMP, RAMP_DOWN),
+	BIND(6, JOY_DOWN, BIND_RELEASE, MECH_RAMP, RAMP_DOWN_RELEASE),
+	BIND(8, JOY_UP, BIND_PRESS, MECH_LIFTER, LIFTER_RAISE),
+	BIND(8, JOY_UP, BIND_RELEASE, MECH_LIFTER, LIFTER_RAISE_RELEASE),
+	BIND(8, JOY_DOWN, BIND_PRESS, MECH_LIFTER, LIFTER_LOWER),
+	BIND(8, JOY_DOWN, BIND_RELEASE, MECH_LIFTER, LIFTER_LOWER_RELEASE),
+	// Manual sorting, one stroke per press
+	BIND(8, JOY_LEFT, BIND_PRESS, MECH_SORTER, SORTER_FRIENDLY),
+	BIND(8, JOY_RIGHT, BIND_PRESS, MECH_SORTER, SORTER_ENEMY),
+	BIND(7, JOY_UP, BIND_PRESS, MECH_MIXER, MIXER_REVERSE),
+	BIND(7, JOY_UP, BIND_RELEASE, MECH_MIXER, MIXER_FORWARD),
+};
+// The same controls with the shooter and ramp groups swapped, for a driver who shoots with
+// the right bumpers
+static const Binding swappedBumperBindings[] = {
+	BIND(7, JOY_RIGHT, BIND_PRESS, MECH_PICKUP, PICKUP_TOGGLE),
+	BIND(7, JOY_LEFT, BIND_PRESS, MECH_PICKUP, PICKUP_HOLD),
+	BIND(7, JOY_LEFT, BIND_RELEASE, MECH_PICKUP, PICKUP_RELEASE),
+	BIND(6, JOY_DOWN, BIND_PRESS, MECH_SHOOTER, SHOOTER_START),
+	BIND(6, JOY_UP, BIND_PRESS, MECH_SHOOTER, SHOOTER_STOP),
+	BIND(5, JOY_UP, BIND_PRESS, MECH_RAMP, RAMP_UP),
+	BIND(5, JOY_UP, BIND_RELEASE, MECH_RAMP, RAMP_UP_RELEASE),
+	BIND(5, JOY_DOWN, BIND_PRESS, MECH_RAMP, RAMP_DOWN),
+	BIND(5, JOY_DOWN, BIND_RELEASE, MECH_RAMP, RAMP_DOWN_RELEASE),
+	BIND(8, JOY_UP, BIND_PRESS, MECH_LIFTER, LIFTER_RAISE),
+	BIND(8, JOY_UP, BIND_RELEASE, MECH_LIFTER, LIFTER_RAISE_RELEASE),
+	BIND(8, JOY_DOWN, BIND_PRESS, MECH_LIFTER, LIFTER_LOWER),
+	BIND(8, JOY_DOWN, BIND_RELEASE, MECH_LIFTER, LIFTER_LOWER_RELEASE),
+	BIND(8, JOY_LEFT, BIND_PRESS, MECH_SORTER, SORTER_FRIENDLY),
+	BIND(8, JOY_RIGHT, BIND_PRESS, MECH_SORTER, SORTER_ENEMY),
+	BIND(7, JOY_UP, BIND_PRESS, MECH_MIXER, MIXER_REVERSE),
+	BIND(7, JOY_UP, BIND_RELEASE, MECH_MIXER, MIXER_FORWARD),
+};
+static const BindingTable driverBindings[] = {
+	BINDING_TABLE(defaultBindings),
+	BINDING_TABLE(swappedBumperBindings),
+};
+// Index into driverBindings of the driver for this match
+#define DRIVER 0
+
+void moveRobot(const int axes[INPUT_AXES]);
 void stopRobot();
-void handlePickup(unsigned char buttonGroup, unsigned char button);
-void sort();
-int getArduinoOut();
 
-void operatorControl() {
-	while (1) {
-		// Drive
-		if (abs(joystickGetAnalog(1,3)) > DEADZONE || abs(joystickGetAnalog(1,4)) > DEADZONE || abs(joystickGetAnalog(1,1)) > DEADZONE)
-			moveRobot();
-		else
-			stopRobot();
-		// End drive
+LoopTimer driveTimer;
+LoopTimer mechanismTimer;
 
-		// Pickup
-		if (joystickGetDigital(1,7,JOY_RIGHT))
-		{
-			handlePickup(7,JOY_RIGHT);
-			if (pickupIsActive)
-				motorSet(PICKUP, 127);
-			else
-				motorStop(PICKUP);
-		}
+// Latest joystick frame, sampled by the drive task and shared with the mechanism task without
+// a lock: the drive task fills the buffer that is not published and then bumps inputSeq, whose
+// low bit names the published one. A copy during which inputSeq moved may be torn and is taken
+// again; the drive task has the higher priority, so it never waits on the mechanism task.
+static InputFrame sharedInput[2];
+static volatile uint32_t inputSeq;
+static volatile TaskHandle mechanismHandle;
+// Set to make the mechanism task exit at the end of its cycle
+static volatile bool mechanismStop;
 
-		if (joystickGetDigital(1, 7, JOY_LEFT))
-			motorSet(PICKUP, 127);
-		else if (!pickupIsActive)
-			motorStop(PICKUP);
-		// End pickup
-
-
-		// Shooter
-		if (joystickGetDigital(1, 5, JOY_DOWN))
-			motorSet(SHOOTER, 80);
-		else if (joystickGetDigital(1, 5, JOY_UP))
-			motorStop(SHOOTER);
-		// End shooter
-
-		// Ramp
-		if (joystickGetDigital(1, 6, JOY_UP))
-			motorSet(RAMP, 65);
-		else if (joystickGetDigital(1, 6, JOY_DOWN))
-			motorSet(RAMP, -65);
-		else
-			motorStop(RAMP);
-		// End ramp
+static void sharedInputPublish(const InputFrame *input)
+{
+	uint32_t seq = __atomic_load_n(&inputSeq, __ATOMIC_RELAXED);
 
-		// Lifter
-		if (digitalRead(LIFTER_SENS_MAX) == LOW) // low when switch is pressed
-			lifterAtMax = 1;
-		else
-			lifterAtMax = 0;
-		if (digitalRead(LIFTER_SENS_MIN) == LOW) // low when switch is pressed
-			lifterAtMin = 1;
-		else
-			lifterAtMin = 0;
-
-		// Go up
-		if (joystickGetDigital(1,8,JOY_UP) && !lifterAtMax)
-			motorSet(LIFTER, 127);
-		// Go down
-		else if (joystickGetDigital(1,8,JOY_DOWN) && !lifterAtMin)
-			motorSet(LIFTER, -127);
-		else
-			motorStop(LIFTER);
-		// End lifter
-
-
-		// Sorter
-		// If either the manual input or the arduino input are set, set flags
-		if ((joystickGetDigital(1,8, JOY_LEFT)) && !sorterEnemy)
-			sorterFriendly = 1;
-		else if ((joystickGetDigital(1,8, JOY_RIGHT) == 1) && !sorterFriendly)
-			sorterEnemy = 1;
-		sort();
-		// End sorter
-
-		// mixer
-		if (joystickGetDigital(1,7, JOY_UP))
-			motorSet(MIXER, -30);
-		else
-			motorSet(MIXER, 30);
-		//end mixer
+	sharedInput[(seq + 1) & 1] = *input;
+	__atomic_store_n(&inputSeq, seq + 1, __ATOMIC_RELEASE);
+}
 
-		printf("%d\n", encoderGet(sorter));
+static void sharedInputGet(InputFrame *input)
+{
+	uint32_t seq;
 
-		delay(20);
-	}
+	do {
+		seq = __atomic_load_n(&inputSeq, __ATOMIC_ACQUIRE);
+		*input = sharedInput[seq & 1];
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while (__atomic_load_n(&inputSeq, __ATOMIC_RELAXED) != seq);
 }
 
-
-void moveRobot()
+static void reportLoop(unsigned char task, const LoopTimer *timer)
 {
-	int control[3];
-	control[0] = joystickGetAnalog(1,3);
-	control[1] = joystickGetAnalog(1,1);
-	control[2] = joystickGetAnalog(1,4);
-
-	int frontLeftPower,
-			frontRightPower,
-			backLeftPower,
-			backRightPower = 0;
-
-	frontLeftPower = 0 - control[1] - control[0] + control[2];
-	frontRightPower = 0 - control[1] + control[0] + control[2];
-	backLeftPower = 0 - control[1] - control[0] - control[2];
-	backRightPower = 0 - control[1] + control[0] - control[2];
-
-	motorSet(M_FRONT_LEFT, frontLeftPower);
-	motorSet(M_FRONT_RIGHT, frontRightPower);
-	motorSet(M_BACK_LEFT, backLeftPower);
-	motorSet(M_BACK_RIGHT, backRightPower);
+	telemetryPush(TELEM_LOOP, TELEM_LOOP_CHANNEL(task, TELEM_LOOP_PERIOD), timer->lastPeriod);
+	telemetryPush(TELEM_LOOP, TELEM_LOOP_CHANNEL(task, TELEM_LOOP_EXEC), timer->lastExec);
+	telemetryPush(TELEM_LOOP, TELEM_LOOP_CHANNEL(task, TELEM_LOOP_OVERRUNS), timer->overruns);
+	telemetryPush(TELEM_LOOP, TELEM_LOOP_CHANNEL(task, TELEM_LOOP_JITTER),
+		loopTimerJitter(timer));
+	telemetryPush(TELEM_LOOP, TELEM_LOOP_CHANNEL(task, TELEM_LOOP_CPU),
+		loopTimerCpuShare(timer));
 }
 
-void stopRobot()
+// Called by the telemetry task every TELEMETRY_PERIOD_MS
+static void reportStats()
 {
-	motorStop(M_FRONT_LEFT);
-	motorStop(M_FRONT_RIGHT);
-	motorStop(M_BACK_LEFT);
-	motorStop(M_BACK_RIGHT);
+	const LifterStats *lifter = lifterGetStats();
+	const PowerStats *power = powerGetStats();
+	const RecorderStats *recorder = recorderGetStats();
+
+	reportLoop(TELEM_TASK_DRIVE, &driveTimer);
+	reportLoop(TELEM_TASK_MECHANISM, &mechanismTimer);
+	reportLoop(TELEM_TASK_TELEMETRY, &telemetryTimer);
+	telemetryPush(TELEM_LIFTER, TELEM_LIFTER_CUTOFFS, lifter->cutoffs);
+	telemetryPush(TELEM_LIFTER, TELEM_LIFTER_STOP_LATENCY, lifter->lastStopLatency);
+	telemetryPush(TELEM_LIFTER, TELEM_LIFTER_POLL_DELAY, lifter->lastPollDelay);
+	telemetryPush(TELEM_POWER, TELEM_POWER_MAIN, power->mainMv);
+	telemetryPush(TELEM_POWER, TELEM_POWER_BACKUP, power->backupMv);
+	telemetryPush(TELEM_POWER, TELEM_POWER_DEMAND, power->demandMa);
+	telemetryPush(TELEM_POWER, TELEM_POWER_BUDGET, power->budgetMa);
+	telemetryPush(TELEM_RECORDER, TELEM_RECORDER_FRAMES, recorder->frames);
+	telemetryPush(TELEM_RECORDER, TELEM_RECORDER_BYTES, recorder->bytes);
+	telemetryPush(TELEM_RECORDER, TELEM_RECORDER_GAPS, recorder->gaps);
+	telemetryPush(TELEM_RECORDER, TELEM_RECORDER_REPLAYED, recorder->replayed);
+	telemetryPush(TELEM_RECORDER, TELEM_RECORDER_REPLAY_ERROR, recorder->maxReplayError);
 }
 
-void handlePickup(unsigned char buttonGroup, unsigned char button)
+/*
+ * Runs the pickup, shooter, ramp, lifter, sorter and mixer at MECHANISM_PERIOD_MS from the most
+ * recent joystick frame published by the drive task. Exits when the competition mode it was
+ * started in ends (operator control, or autonomous replaying a recording), since the kernel only
+ * stops the task running operatorControl() itself, or when mechanismStop is set. It always exits
+ * on its own between cycles rather than being deleted, so it never dies holding the motor stage.
+ */
+static void mechanismTask(void *ignore)
 {
-	if ((millis() - pickupLastTime) > debounceDelay)
-	{
-		pickupIsActive = !pickupIsActive;
-		pickupLastTime = millis();
+	InputFrame input;
+	SensorFrame sensors;
+	Buttons buttons;
+	ArduinoBall ball;
+	const Buttons *btn = &buttons;
+	const SensorFrame *sens = &sensors;
+	bool autonomousMode = isAutonomous();
+
+	bindingsSelect(&driverBindings[DRIVER]);
+	mechanismsStart();
+	buttonsInit(&buttons);
+	buttonsSetDebounce(&buttons, INPUT_BUTTON(7, JOY_RIGHT), PICKUP_DEBOUNCE_MS);
+	loopTimerInit(&mechanismTimer, MECHANISM_PERIOD_MS);
+	while (isEnabled() && isAutonomous() == autonomousMode && !mechanismStop) {
+		loopTimerBegin(&mechanismTimer);
+		sharedInputGet(&input);
+		sensorsSample(&sensors);
+		buttonsUpdate(&buttons, &input);
+
+		// Turn button edges and classified balls into mechanism events
+		PROF_BEGIN(PROF_BINDINGS);
+		bindingsUpdate(btn);
+		while (arduinoPoll(&ball))
+			fsmPost(MECH_SORTER, ball.enemy ? SORTER_ENEMY : SORTER_FRIENDLY, (long)ball.time);
+		PROF_END(PROF_BINDINGS);
+
+		// Pickup, shooter, ramp, lifter, sorter and mixer
+		PROF_BEGIN(PROF_MECHANISMS);
+		mechanismsUpdate(sens);
+		PROF_END(PROF_MECHANISMS);
+
+		powerUpdate();
+		// The drive task owns the drive ports
+		motorsFlushPorts(MOTOR_ALL_PORTS & ~DRIVE_PORTS);
+
+		telemetryPush(TELEM_ENCODER, QUAD_TOP_PORT, sens->sorterCount);
+		telemetryPush(TELEM_SWITCH, LIFTER_SENS_MAX, sensorDigital(sens, LIFTER_SENS_MAX));
+		telemetryPush(TELEM_SWITCH, LIFTER_SENS_MIN, sensorDigital(sens, LIFTER_SENS_MIN));
+
+		loopTimerWait(&mechanismTimer);
 	}
+	mechanismHandle = NULL;
+	taskDelete(NULL);
 }
 
-void sort()
-{
-	if (sorterFriendly && (!sorterEnemy))
-	{
-		if (encoderGet(sorter) <= 90)
-		{
-			motorSet(SORTER, 20);
-		}
-		else if (encoderGet(sorter) > 90)
-		{
-			motorStop(SORTER);
-			sorterFriendly = 0;
-			encoderReset(sorter);
-		}
-	}
-	else if (sorterEnemy && (!sorterFriendly))
-	{
-		if (encoderGet(sorter) >= -90)
-		{
-			motorSet(SORTER, -20);
-		}
-		else if (encoderGet(sorter) < -90)
+/*
+ * operatorControl() itself is the drive task: it samples the joystick and drives the wheels at
+ * DRIVE_PERIOD_MS and DRIVE_PRIORITY so slower mechanism and telemetry work cannot delay it.
+ */
+void operatorControl() {
+	InputFrame input;
+	int axes[INPUT_AXES];
+	bool recordHeld = false;
+
+	// A mechanism task left over from an earlier operator control period is stale; it finishes
+	// its cycle and exits
+	mechanismStop = true;
+	while (mechanismHandle != NULL)
+		delay(MECHANISM_PERIOD_MS);
+	mechanismStop = false;
+
+	motorsInit();
+	powerInit();
+	shapingInit(DEADZONE);
+	// Only axis 1 of the right stick is used, and axis 2 must not pull turn out of its deadzone
+	shapingSetDeadzoneShape(SHAPE_STICK_RIGHT, SHAPE_AXIAL);
+	shapingSetCurve(AXIS_LEFT_Y, FORWARD_CURVE);
+	shapingSetCurve(AXIS_LEFT_X, STRAFE_CURVE);
+	shapingSetCurve(AXIS_RIGHT_X, TURN_CURVE);
+	sorterInit();
+	// autonomous() runs this code on a recording; anywhere else the joystick is the input
+	if (!isAutonomous())
+		inputSetSource(NULL);
+	// The drive loop samples the first real frame before the mechanism task can run
+	memset(sharedInput, 0, sizeof(sharedInput));
+	inputSeq = 0;
+	telemetrySetSampler(reportStats);
+	taskPrioritySet(NULL, DRIVE_PRIORITY);
+	mechanismHandle = taskCreate(mechanismTask, TASK_DEFAULT_STACK_SIZE, NULL,
+		MECHANISM_PRIORITY);
+
+	loopTimerInit(&driveTimer, DRIVE_PERIOD_MS);
+	while (1) {
+		loopTimerBegin(&driveTimer);
+		inputSample(&input, 1);
+		sharedInputPublish(&input);
+
+		// Drive
+		PROF_BEGIN(PROF_DRIVE);
+		shapingApply(&input, axes);
+		if (axes[AXIS_LEFT_Y - 1] != 0 || axes[AXIS_LEFT_X - 1] != 0 || axes[AXIS_RIGHT_X - 1] != 0)
+			moveRobot(axes);
+		else
+			stopRobot();
+		PROF_END(PROF_DRIVE);
+		// End drive
+
+		motorsFlushPorts(DRIVE_PORTS);
+
+		// Recording
+		if (inputDigital(&input, RECORD_GROUP, RECORD_BUTTON) && !recordHeld &&
+			!isOnline() && !isAutonomous())
+			recorderStart();
+		recordHeld = inputDigital(&input, RECORD_GROUP, RECORD_BUTTON);
+		recorderAdd(&input);
+		// PROS needs the actuators stopped while it writes to flash
+		if (recorderState() == RECORDER_FINISHED)
 		{
-			motorStop(SORTER);
-			sorterEnemy = 0;
-			encoderReset(sorter);
+			motorsSuspend();
+			recorderSave(RECORDER_FILE);
+			motorsResume();
 		}
+		loopTimerWait(&driveTimer);
 	}
 }
 
-int getArduinoOut()
+
+void moveRobot(const int axes[INPUT_AXES])
 {
-	// If the arduino ouput pin is high, the ball is enemy team therefore return 1
-	// otherwise return 0
-	//if (digitalRead(ARDUINO_SENS_OUT))
-	//	return 1;
-	//else
-	//	return 0;
-	return 2;
+	driveMecanum(axes[AXIS_LEFT_Y - 1], axes[AXIS_RIGHT_X - 1], axes[AXIS_LEFT_X - 1]);
 }
+
+void stopRobot()
+{
+	driveStop();
+}
+
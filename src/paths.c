@@ -0,0 +1,832 @@
+/** @file paths.c
+ * @brief Autonomous drive trajectories
+ *
+ * Generated by tools/mktraj.c from tools/paths.txt; do not edit. Run make paths after
+ * changing the paths.
+ */
+
+#include "main.h"
+#include "paths.h"
+
+// 818 points, 8.18 s
+static const TrajectoryPoint autoPathPoints[] = {
+	{ { -8, 8, -8, 8 } },
+	{ { -24, 24, -24, 24 } },
+	{ { -40, 40, -40, 40 } },
+	{ { -56, 56, -56, 56 } },
+	{ { -72, 72, -72, 72 } },
+	{ { -88, 88, -88, 88 } },
+	{ { -104, 104, -104, 104 } },
+	{ { -120, 120, -120, 120 } },
+	{ { -136, 136, -136, 136 } },
+	{ { -152, 152, -152, 152 } },
+	{ { -168, 168, -168, 168 } },
+	{ { -184, 184, -184, 184 } },
+	{ { -200, 200, -200, 200 } },
+	{ { -216, 216, -216, 216 } },
+	{ { -232, 232, -232, 232 } },
+	{ { -248, 248, -248, 248 } },
+	{ { -264, 264, -264, 264 } },
+	{ { -280, 280, -280, 280 } },
+	{ { -296, 296, -296, 296 } },
+	{ { -312, 312, -312, 312 } },
+	{ { -328, 328, -328, 328 } },
+	{ { -344, 344, -344, 344 } },
+	{ { -360, 360, -360, 360 } },
+	{ { -376, 376, -376, 376 } },
+	{ { -392, 392, -392, 392 } },
+	{ { -408, 408, -408, 408 } },
+	{ { -424, 424, -424, 424 } },
+	{ { -440, 440, -440, 440 } },
+	{ { -456, 456, -456, 456 } },
+	{ { -472, 472, -472, 472 } },
+	{ { -488, 488, -488, 488 } },
+	{ { -504, 504, -504, 504 } },
+	{ { -520, 520, -520, 520 } },
+	{ { -536, 536, -536, 536 } },
+	{ { -552, 552, -552, 552 } },
+	{ { -568, 568, -568, 568 } },
+	{ { -584, 584, -584, 584 } },
+	{ { -600, 600, -600, 600 } },
+	{ { -616, 616, -616, 616 } },
+	{ { -632, 632, -632, 632 } },
+	{ { -648, 648, -648, 648 } },
+	{ { -664, 664, -664, 664 } },
+	{ { -680, 680, -680, 680 } },
+	{ { -696, 696, -696, 696 } },
+	{ { -712, 712, -712, 712 } },
+	{ { -728, 728, -728, 728 } },
+	{ { -744, 744, -744, 744 } },
+	{ { -760, 760, -760, 760 } },
+	{ { -776, 776, -776, 776 } },
+	{ { -792, 792, -792, 792 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -800, 800, -800, 800 } },
+	{ { -799, 799, -799, 799 } },
+	{ { -785, 785, -785, 785 } },
+	{ { -770, 770, -770, 770 } },
+	{ { -753, 753, -753, 753 } },
+	{ { -738, 738, -738, 738 } },
+	{ { -722, 722, -722, 722 } },
+	{ { -705, 705, -705, 705 } },
+	{ { -690, 690, -690, 690 } },
+	{ { -673, 673, -673, 673 } },
+	{ { -658, 658, -658, 658 } },
+	{ { -642, 642, -642, 642 } },
+	{ { -625, 625, -625, 625 } },
+	{ { -610, 610, -610, 610 } },
+	{ { -593, 593, -593, 593 } },
+	{ { -578, 578, -578, 578 } },
+	{ { -562, 562, -562, 562 } },
+	{ { -545, 545, -545, 545 } },
+	{ { -530, 530, -530, 530 } },
+	{ { -513, 513, -513, 513 } },
+	{ { -498, 498, -498, 498 } },
+	{ { -482, 482, -482, 482 } },
+	{ { -465, 465, -465, 465 } },
+	{ { -450, 450, -450, 450 } },
+	{ { -433, 433, -433, 433 } },
+	{ { -418, 418, -418, 418 } },
+	{ { -401, 401, -401, 401 } },
+	{ { -386, 386, -386, 386 } },
+	{ { -370, 370, -370, 370 } },
+	{ { -353, 353, -353, 353 } },
+	{ { -338, 338, -338, 338 } },
+	{ { -321, 321, -321, 321 } },
+	{ { -306, 306, -306, 306 } },
+	{ { -290, 290, -290, 290 } },
+	{ { -273, 273, -273, 273 } },
+	{ { -258, 258, -258, 258 } },
+	{ { -241, 241, -241, 241 } },
+	{ { -226, 226, -226, 226 } },
+	{ { -210, 210, -210, 210 } },
+	{ { -193, 193, -193, 193 } },
+	{ { -178, 178, -178, 178 } },
+	{ { -161, 161, -161, 161 } },
+	{ { -146, 146, -146, 146 } },
+	{ { -130, 130, -130, 130 } },
+	{ { -113, 113, -113, 113 } },
+	{ { -98, 98, -98, 98 } },
+	{ { -81, 81, -81, 81 } },
+	{ { -66, 66, -66, 66 } },
+	{ { -50, 50, -50, 50 } },
+	{ { -33, 33, -33, 33 } },
+	{ { -18, 18, -18, 18 } },
+	{ { -3, 3, -3, 3 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 0, 0, 0, 0 } },
+	{ { -8, -8, 8, 8 } },
+	{ { -24, -24, 24, 24 } },
+	{ { -40, -40, 40, 40 } },
+	{ { -56, -56, 56, 56 } },
+	{ { -72, -72, 72, 72 } },
+	{ { -88, -88, 88, 88 } },
+	{ { -104, -104, 104, 104 } },
+	{ { -120, -120, 120, 120 } },
+	{ { -136, -136, 136, 136 } },
+	{ { -152, -152, 152, 152 } },
+	{ { -168, -168, 168, 168 } },
+	{ { -184, -184, 184, 184 } },
+	{ { -200, -200, 200, 200 } },
+	{ { -216, -216, 216, 216 } },
+	{ { -232, -232, 232, 232 } },
+	{ { -248, -248, 248, 248 } },
+	{ { -264, -264, 264, 264 } },
+	{ { -280, -280, 280, 280 } },
+	{ { -296, -296, 296, 296 } },
+	{ { -312, -312, 312, 312 } },
+	{ { -328, -328, 328, 328 } },
+	{ { -344, -344, 344, 344 } },
+	{ { -360, -360, 360, 360 } },
+	{ { -376, -376, 376, 376 } },
+	{ { -392, -392, 392, 392 } },
+	{ { -408, -408, 408, 408 } },
+	{ { -424, -424, 424, 424 } },
+	{ { -440, -440, 440, 440 } },
+	{ { -456, -456, 456, 456 } },
+	{ { -472, -472, 472, 472 } },
+	{ { -488, -488, 488, 488 } },
+	{ { -504, -504, 504, 504 } },
+	{ { -520, -520, 520, 520 } },
+	{ { -536, -536, 536, 536 } },
+	{ { -552, -552, 552, 552 } },
+	{ { -568, -568, 568, 568 } },
+	{ { -584, -584, 584, 584 } },
+	{ { -600, -600, 600, 600 } },
+	{ { -616, -616, 616, 616 } },
+	{ { -632, -632, 632, 632 } },
+	{ { -648, -648, 648, 648 } },
+	{ { -664, -664, 664, 664 } },
+	{ { -680, -680, 680, 680 } },
+	{ { -696, -696, 696, 696 } },
+	{ { -712, -712, 712, 712 } },
+	{ { -728, -728, 728, 728 } },
+	{ { -744, -744, 744, 744 } },
+	{ { -760, -760, 760, 760 } },
+	{ { -776, -776, 776, 776 } },
+	{ { -792, -792, 792, 792 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -800, -800, 800, 800 } },
+	{ { -796, -796, 796, 796 } },
+	{ { -781, -781, 781, 781 } },
+	{ { -765, -765, 765, 765 } },
+	{ { -748, -748, 748, 748 } },
+	{ { -733, -733, 733, 733 } },
+	{ { -717, -717, 717, 717 } },
+	{ { -701, -701, 701, 701 } },
+	{ { -685, -685, 685, 685 } },
+	{ { -668, -668, 668, 668 } },
+	{ { -653, -653, 653, 653 } },
+	{ { -637, -637, 637, 637 } },
+	{ { -621, -621, 621, 621 } },
+	{ { -605, -605, 605, 605 } },
+	{ { -588, -588, 588, 588 } },
+	{ { -573, -573, 573, 573 } },
+	{ { -557, -557, 557, 557 } },
+	{ { -541, -541, 541, 541 } },
+	{ { -525, -525, 525, 525 } },
+	{ { -508, -508, 508, 508 } },
+	{ { -493, -493, 493, 493 } },
+	{ { -477, -477, 477, 477 } },
+	{ { -461, -461, 461, 461 } },
+	{ { -445, -445, 445, 445 } },
+	{ { -428, -428, 428, 428 } },
+	{ { -413, -413, 413, 413 } },
+	{ { -397, -397, 397, 397 } },
+	{ { -381, -381, 381, 381 } },
+	{ { -365, -365, 365, 365 } },
+	{ { -348, -348, 348, 348 } },
+	{ { -333, -333, 333, 333 } },
+	{ { -317, -317, 317, 317 } },
+	{ { -301, -301, 301, 301 } },
+	{ { -285, -285, 285, 285 } },
+	{ { -268, -268, 268, 268 } },
+	{ { -253, -253, 253, 253 } },
+	{ { -237, -237, 237, 237 } },
+	{ { -221, -221, 221, 221 } },
+	{ { -205, -205, 205, 205 } },
+	{ { -188, -188, 188, 188 } },
+	{ { -173, -173, 173, 173 } },
+	{ { -157, -157, 157, 157 } },
+	{ { -141, -141, 141, 141 } },
+	{ { -124, -124, 124, 124 } },
+	{ { -109, -109, 109, 109 } },
+	{ { -93, -93, 93, 93 } },
+	{ { -77, -77, 77, 77 } },
+	{ { -61, -61, 61, 61 } },
+	{ { -44, -44, 44, 44 } },
+	{ { -29, -29, 29, 29 } },
+	{ { -13, -13, 13, 13 } },
+	{ { -1, -1, 1, 1 } },
+	{ { -8, -8, -8, -8 } },
+	{ { -24, -24, -24, -24 } },
+	{ { -40, -40, -40, -40 } },
+	{ { -56, -56, -56, -56 } },
+	{ { -72, -72, -72, -72 } },
+	{ { -88, -88, -88, -88 } },
+	{ { -104, -104, -104, -104 } },
+	{ { -120, -120, -120, -120 } },
+	{ { -136, -136, -136, -136 } },
+	{ { -152, -152, -152, -152 } },
+	{ { -168, -168, -168, -168 } },
+	{ { -184, -184, -184, -184 } },
+	{ { -200, -200, -200, -200 } },
+	{ { -216, -216, -216, -216 } },
+	{ { -232, -232, -232, -232 } },
+	{ { -248, -248, -248, -248 } },
+	{ { -264, -264, -264, -264 } },
+	{ { -280, -280, -280, -280 } },
+	{ { -296, -296, -296, -296 } },
+	{ { -312, -312, -312, -312 } },
+	{ { -328, -328, -328, -328 } },
+	{ { -344, -344, -344, -344 } },
+	{ { -360, -360, -360, -360 } },
+	{ { -376, -376, -376, -376 } },
+	{ { -392, -392, -392, -392 } },
+	{ { -408, -408, -408, -408 } },
+	{ { -424, -424, -424, -424 } },
+	{ { -440, -440, -440, -440 } },
+	{ { -456, -456, -456, -456 } },
+	{ { -472, -472, -472, -472 } },
+	{ { -488, -488, -488, -488 } },
+	{ { -504, -504, -504, -504 } },
+	{ { -520, -520, -520, -520 } },
+	{ { -536, -536, -536, -536 } },
+	{ { -552, -552, -552, -552 } },
+	{ { -568, -568, -568, -568 } },
+	{ { -584, -584, -584, -584 } },
+	{ { -600, -600, -600, -600 } },
+	{ { -616, -616, -616, -616 } },
+	{ { -632, -632, -632, -632 } },
+	{ { -648, -648, -648, -648 } },
+	{ { -664, -664, -664, -664 } },
+	{ { -680, -680, -680, -680 } },
+	{ { -696, -696, -696, -696 } },
+	{ { -712, -712, -712, -712 } },
+	{ { -728, -728, -728, -728 } },
+	{ { -744, -744, -744, -744 } },
+	{ { -760, -760, -760, -760 } },
+	{ { -776, -776, -776, -776 } },
+	{ { -792, -792, -792, -792 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -800, -800, -800, -800 } },
+	{ { -794, -794, -794, -794 } },
+	{ { -777, -777, -777, -777 } },
+	{ { -762, -762, -762, -762 } },
+	{ { -745, -745, -745, -745 } },
+	{ { -730, -730, -730, -730 } },
+	{ { -714, -714, -714, -714 } },
+	{ { -697, -697, -697, -697 } },
+	{ { -682, -682, -682, -682 } },
+	{ { -665, -665, -665, -665 } },
+	{ { -650, -650, -650, -650 } },
+	{ { -634, -634, -634, -634 } },
+	{ { -617, -617, -617, -617 } },
+	{ { -602, -602, -602, -602 } },
+	{ { -585, -585, -585, -585 } },
+	{ { -570, -570, -570, -570 } },
+	{ { -554, -554, -554, -554 } },
+	{ { -537, -537, -537, -537 } },
+	{ { -522, -522, -522, -522 } },
+	{ { -505, -505, -505, -505 } },
+	{ { -490, -490, -490, -490 } },
+	{ { -474, -474, -474, -474 } },
+	{ { -457, -457, -457, -457 } },
+	{ { -442, -442, -442, -442 } },
+	{ { -425, -425, -425, -425 } },
+	{ { -410, -410, -410, -410 } },
+	{ { -394, -394, -394, -394 } },
+	{ { -377, -377, -377, -377 } },
+	{ { -362, -362, -362, -362 } },
+	{ { -345, -345, -345, -345 } },
+	{ { -330, -330, -330, -330 } },
+	{ { -314, -314, -314, -314 } },
+	{ { -297, -297, -297, -297 } },
+	{ { -282, -282, -282, -282 } },
+	{ { -265, -265, -265, -265 } },
+	{ { -250, -250, -250, -250 } },
+	{ { -234, -234, -234, -234 } },
+	{ { -217, -217, -217, -217 } },
+	{ { -202, -202, -202, -202 } },
+	{ { -185, -185, -185, -185 } },
+	{ { -170, -170, -170, -170 } },
+	{ { -154, -154, -154, -154 } },
+	{ { -137, -137, -137, -137 } },
+	{ { -122, -122, -122, -122 } },
+	{ { -105, -105, -105, -105 } },
+	{ { -90, -90, -90, -90 } },
+	{ { -74, -74, -74, -74 } },
+	{ { -57, -57, -57, -57 } },
+	{ { -42, -42, -42, -42 } },
+	{ { -25, -25, -25, -25 } },
+	{ { -10, -10, -10, -10 } },
+	{ { 0, 0, 0, 0 } },
+	{ { 6, -6, 6, -6 } },
+	{ { 18, -18, 18, -18 } },
+	{ { 30, -30, 30, -30 } },
+	{ { 42, -42, 42, -42 } },
+	{ { 54, -54, 54, -54 } },
+	{ { 66, -66, 66, -66 } },
+	{ { 78, -78, 78, -78 } },
+	{ { 90, -90, 90, -90 } },
+	{ { 102, -102, 102, -102 } },
+	{ { 114, -114, 114, -114 } },
+	{ { 126, -126, 126, -126 } },
+	{ { 138, -138, 138, -138 } },
+	{ { 150, -150, 150, -150 } },
+	{ { 162, -162, 162, -162 } },
+	{ { 174, -174, 174, -174 } },
+	{ { 186, -186, 186, -186 } },
+	{ { 198, -198, 198, -198 } },
+	{ { 210, -210, 210, -210 } },
+	{ { 222, -222, 222, -222 } },
+	{ { 234, -234, 234, -234 } },
+	{ { 246, -246, 246, -246 } },
+	{ { 258, -258, 258, -258 } },
+	{ { 270, -270, 270, -270 } },
+	{ { 282, -282, 282, -282 } },
+	{ { 294, -294, 294, -294 } },
+	{ { 306, -306, 306, -306 } },
+	{ { 318, -318, 318, -318 } },
+	{ { 330, -330, 330, -330 } },
+	{ { 342, -342, 342, -342 } },
+	{ { 354, -354, 354, -354 } },
+	{ { 366, -366, 366, -366 } },
+	{ { 378, -378, 378, -378 } },
+	{ { 390, -390, 390, -390 } },
+	{ { 402, -402, 402, -402 } },
+	{ { 414, -414, 414, -414 } },
+	{ { 426, -426, 426, -426 } },
+	{ { 438, -438, 438, -438 } },
+	{ { 450, -450, 450, -450 } },
+	{ { 462, -462, 462, -462 } },
+	{ { 474, -474, 474, -474 } },
+	{ { 486, -486, 486, -486 } },
+	{ { 497, -497, 497, -497 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 500, -500, 500, -500 } },
+	{ { 491, -491, 491, -491 } },
+	{ { 480, -480, 480, -480 } },
+	{ { 467, -467, 467, -467 } },
+	{ { 456, -456, 456, -456 } },
+	{ { 443, -443, 443, -443 } },
+	{ { 432, -432, 432, -432 } },
+	{ { 419, -419, 419, -419 } },
+	{ { 408, -408, 408, -408 } },
+	{ { 395, -395, 395, -395 } },
+	{ { 383, -383, 383, -383 } },
+	{ { 372, -372, 372, -372 } },
+	{ { 359, -359, 359, -359 } },
+	{ { 348, -348, 348, -348 } },
+	{ { 335, -335, 335, -335 } },
+	{ { 324, -324, 324, -324 } },
+	{ { 311, -311, 311, -311 } },
+	{ { 299, -299, 299, -299 } },
+	{ { 288, -288, 288, -288 } },
+	{ { 275, -275, 275, -275 } },
+	{ { 264, -264, 264, -264 } },
+	{ { 251, -251, 251, -251 } },
+	{ { 240, -240, 240, -240 } },
+	{ { 227, -227, 227, -227 } },
+	{ { 216, -216, 216, -216 } },
+	{ { 203, -203, 203, -203 } },
+	{ { 191, -191, 191, -191 } },
+	{ { 180, -180, 180, -180 } },
+	{ { 167, -167, 167, -167 } },
+	{ { 156, -156, 156, -156 } },
+	{ { 143, -143, 143, -143 } },
+	{ { 132, -132, 132, -132 } },
+	{ { 119, -119, 119, -119 } },
+	{ { 107, -107, 107, -107 } },
+	{ { 96, -96, 96, -96 } },
+	{ { 83, -83, 83, -83 } },
+	{ { 72, -72, 72, -72 } },
+	{ { 59, -59, 59, -59 } },
+	{ { 48, -48, 48, -48 } },
+	{ { 35, -35, 35, -35 } },
+	{ { 24, -24, 24, -24 } },
+	{ { 11, -11, 11, -11 } },
+	{ { 1, -1, 1, -1 } },
+};
+const Trajectory autoPath = { autoPathPoints, 818 };
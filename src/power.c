@@ -0,0 +1,109 @@
+/** @file power.c
+ * @brief Battery-aware motor current budget
+ */
+
+#include "main.h"
+
+// Priority level of each port; the highest level is shaved first
+static const unsigned char priorities[MOTOR_PORTS] = {
+	[M_FRONT_LEFT - 1] = 0,
+	[M_FRONT_RIGHT - 1] = 0,
+	[M_BACK_LEFT - 1] = 0,
+	[M_BACK_RIGHT - 1] = 0,
+	[LIFTER - 1] = 1,
+	[SORTER - 1] = 1,
+	[SHOOTER - 1] = 2,
+	[PICKUP - 1] = 2,
+	[RAMP - 1] = 3,
+	[MIXER - 1] = 3,
+};
+
+static PowerStats stats;
+
+// First-order filter with a gain of 1/4 so single noisy ADC readings do not trip the budget
+static unsigned int powerFilter(unsigned int filtered, unsigned int sample)
+{
+	return (unsigned int)((int)filtered + ((int)sample - (int)filtered) / 4);
+}
+
+static unsigned long powerBudget()
+{
+	unsigned long budget;
+
+	if (stats.mainMv >= POWER_SAG_MV)
+		budget = POWER_BUDGET_MA;
+	else if (stats.mainMv <= POWER_LOW_MV)
+		budget = POWER_FLOOR_MA;
+	else
+		budget = POWER_FLOOR_MA + (unsigned long)(POWER_BUDGET_MA - POWER_FLOOR_MA) *
+			(stats.mainMv - POWER_LOW_MV) / (POWER_SAG_MV - POWER_LOW_MV);
+	if (stats.backupMv < POWER_BACKUP_LOW_MV)
+		budget = budget * 3 / 4;
+	return budget;
+}
+
+void powerInit()
+{
+	unsigned char i;
+
+	stats.mainMv = powerLevelMain();
+	stats.backupMv = powerLevelBackup();
+	stats.minMainMv = stats.mainMv;
+	stats.demandMa = 0;
+	stats.budgetMa = powerBudget();
+	stats.peakDemandMa = 0;
+	stats.shavedUpdates = 0;
+	for (i = 1; i <= MOTOR_PORTS; i++)
+		motorsSetScale(i, 100);
+}
+
+void powerUpdate()
+{
+	unsigned long demand[POWER_LEVELS] = { 0 };
+	unsigned char scale[POWER_LEVELS];
+	unsigned long total = 0;
+	unsigned long excess;
+	unsigned char i;
+	int level;
+
+	stats.mainMv = powerFilter(stats.mainMv, powerLevelMain());
+	stats.backupMv = powerFilter(stats.backupMv, powerLevelBackup());
+	if (stats.mainMv < stats.minMainMv)
+		stats.minMainMv = stats.mainMv;
+	stats.budgetMa = powerBudget();
+
+	for (i = 0; i < MOTOR_PORTS; i++)
+	{
+		// Draw scales with the command and with the voltage across the motor
+		unsigned long ma = (unsigned long)abs(motorsGetCommand(i + 1)) * POWER_FULL_LOAD_MA /
+			127 * stats.mainMv / POWER_NOMINAL_MV;
+
+		demand[priorities[i]] += ma;
+		total += ma;
+	}
+	stats.demandMa = total;
+	if (total > stats.peakDemandMa)
+		stats.peakDemandMa = total;
+
+	// The estimate takes no account of how fast each motor already turns, so it reads high
+	// whenever the robot is simply moving. Only hold it to the budget once the battery sags.
+	// Take the excess out of the lowest priorities first, scaling each level as a whole
+	excess = stats.mainMv < POWER_SAG_MV && total > stats.budgetMa ? total - stats.budgetMa : 0;
+	if (excess > 0)
+		stats.shavedUpdates++;
+	for (level = POWER_LEVELS - 1; level >= 0; level--)
+	{
+		unsigned long cut = excess < demand[level] ? excess : demand[level];
+
+		scale[level] = demand[level] == 0 ? 100 :
+			(unsigned char)((demand[level] - cut) * 100 / demand[level]);
+		excess -= cut;
+	}
+	for (i = 0; i < MOTOR_PORTS; i++)
+		motorsSetScale(i + 1, scale[priorities[i]]);
+}
+
+const PowerStats* powerGetStats()
+{
+	return &stats;
+}
@@ -0,0 +1,77 @@
+/** @file prof.c
+ * @brief Per-section loop profiler
+ */
+
+#include "main.h"
+
+#if PROF_ENABLED
+
+static ProfSection sections[PROF_SECTIONS];
+
+void profRecord(unsigned char section, unsigned long micros)
+{
+	ProfSection *s;
+	unsigned char bucket;
+
+	if (section >= PROF_SECTIONS)
+		return;
+	s = &sections[section];
+	if (s->count == 0 || micros < s->min)
+		s->min = micros;
+	if (micros > s->max)
+		s->max = micros;
+	s->total += micros;
+	s->count++;
+	// Index of the highest set bit, so bucket k holds 2^k to 2^(k+1) - 1
+	bucket = (unsigned char)(31 - __builtin_clz(micros | 1));
+	if (bucket >= PROF_BUCKETS)
+		bucket = PROF_BUCKETS - 1;
+	s->buckets[bucket]++;
+}
+
+void profReset()
+{
+	unsigned char i, j;
+
+	for (i = 0; i < PROF_SECTIONS; i++)
+	{
+		sections[i].count = 0;
+		sections[i].min = 0;
+		sections[i].max = 0;
+		sections[i].total = 0;
+		for (j = 0; j < PROF_BUCKETS; j++)
+			sections[i].buckets[j] = 0;
+	}
+}
+
+const ProfSection* profGet(unsigned char section)
+{
+	if (section >= PROF_SECTIONS)
+		return NULL;
+	return &sections[section];
+}
+
+void profDump()
+{
+	unsigned char i, j;
+
+	for (i = 0; i < PROF_SECTIONS; i++)
+	{
+		const ProfSection *s = &sections[i];
+		unsigned long count = s->count;
+
+		if (count == 0)
+			continue;
+		telemetryPush(TELEM_PROFILE, TELEM_PROFILE_CHANNEL(i, TELEM_PROFILE_COUNT), count);
+		telemetryPush(TELEM_PROFILE, TELEM_PROFILE_CHANNEL(i, TELEM_PROFILE_MIN), s->min);
+		telemetryPush(TELEM_PROFILE, TELEM_PROFILE_CHANNEL(i, TELEM_PROFILE_MAX), s->max);
+		telemetryPush(TELEM_PROFILE, TELEM_PROFILE_CHANNEL(i, TELEM_PROFILE_MEAN),
+			(int32_t)(s->total / count));
+		for (j = 0; j < PROF_BUCKETS; j++)
+			if (s->buckets[j] != 0)
+				telemetryPush(TELEM_PROFILE,
+					TELEM_PROFILE_CHANNEL(i, TELEM_PROFILE_BUCKET + j), s->buckets[j]);
+	}
+}
+
+#endif
@@ -0,0 +1,243 @@
+/** @file recorder.c
+ * @brief Driver input recording and replay
+ */
+
+#include "main.h"
+#include <string.h>
+
+// Encoding: a header byte with bit 7 clear flags the fields that follow (bit i for axis i + 1,
+// bit 4 for the buttons, low byte first); one with bit 7 set repeats the previous frame
+// (header & 0x7F) + 1 times
+#define RECORDER_RUN 0x80
+#define RECORDER_RUN_MAX 128
+#define RECORDER_BUTTONS 0x10
+
+// Magic of a recording file, followed by the frame and byte counts and the encoded frames
+#define RECORDER_MAGIC "REC1"
+
+typedef struct {
+	char magic[4];
+	unsigned short frames;
+	unsigned short bytes;
+} RecorderHeader;
+
+static unsigned char buffer[RECORDER_BUFFER_SIZE];
+static unsigned char state;
+// Last frame recorded or replayed, which the next one is encoded against
+static InputFrame previous;
+// Index in buffer of the run header being extended, or -1 if the last entry was not a run
+static int run;
+// millis() of the first recorded frame
+static unsigned long startTime;
+// Read position in buffer, and repeats of previous still to hand out
+static unsigned int position;
+static unsigned int repeats;
+// micros() when replay started
+static unsigned long replayStart;
+
+static RecorderStats stats;
+
+static void recorderClear()
+{
+	unsigned char i;
+
+	for (i = 0; i < INPUT_AXES; i++)
+		previous.axis[i] = 0;
+	previous.buttons = 0;
+	run = -1;
+	position = 0;
+	repeats = 0;
+	stats.frames = 0;
+	stats.bytes = 0;
+	stats.gaps = 0;
+	stats.replayed = 0;
+	stats.maxReplayError = 0;
+}
+
+void recorderStart()
+{
+	recorderClear();
+	state = RECORDER_RECORDING;
+}
+
+// Appends one frame; the buffer always has room, as it is sized for the worst case
+static void recorderEncode(const InputFrame *frame)
+{
+	unsigned char header = 0;
+	unsigned char i;
+
+	for (i = 0; i < INPUT_AXES; i++)
+		if (frame->axis[i] != previous.axis[i])
+			header |= 1 << i;
+	if (frame->buttons != previous.buttons)
+		header |= RECORDER_BUTTONS;
+
+	if (header == 0)
+	{
+		if (run >= 0 && (buffer[run] & ~RECORDER_RUN) < RECORDER_RUN_MAX - 1)
+			buffer[run]++;
+		else
+		{
+			run = stats.bytes;
+			buffer[stats.bytes++] = RECORDER_RUN;
+		}
+	}
+	else
+	{
+		run = -1;
+		buffer[stats.bytes++] = header;
+		for (i = 0; i < INPUT_AXES; i++)
+			if (header & (1 << i))
+				buffer[stats.bytes++] = (unsigned char)frame->axis[i];
+		if (header & RECORDER_BUTTONS)
+		{
+			buffer[stats.bytes++] = (unsigned char)(frame->buttons & 0xFF);
+			buffer[stats.bytes++] = (unsigned char)(frame->buttons >> 8);
+		}
+	}
+	previous = *frame;
+	stats.frames++;
+}
+
+void recorderAdd(const InputFrame *frame)
+{
+	unsigned long slot;
+
+	if (state != RECORDER_RECORDING)
+		return;
+	if (stats.frames == 0)
+		startTime = frame->time;
+	// A drive cycle the loop skipped still takes a slot, so replay keeps the recorded timing
+	slot = (frame->time - startTime + RECORDER_PERIOD_MS / 2) / RECORDER_PERIOD_MS;
+	while (stats.frames < slot && stats.frames < RECORDER_DURATION_MS / RECORDER_PERIOD_MS)
+	{
+		InputFrame repeat = previous;
+
+		recorderEncode(&repeat);
+		stats.gaps++;
+	}
+	if (stats.frames < RECORDER_DURATION_MS / RECORDER_PERIOD_MS)
+		recorderEncode(frame);
+	if (stats.frames >= RECORDER_DURATION_MS / RECORDER_PERIOD_MS)
+		state = RECORDER_FINISHED;
+}
+
+bool recorderSave(const char *file)
+{
+	RecorderHeader header = {
+		.magic = RECORDER_MAGIC,
+		.frames = (unsigned short)stats.frames,
+		.bytes = (unsigned short)stats.bytes
+	};
+	PROS_FILE *out;
+	bool ok;
+
+	if (state != RECORDER_FINISHED)
+		return false;
+	out = fopen(file, "w");
+	if (out == NULL)
+		return false;
+	ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+		fwrite(buffer, 1, stats.bytes, out) == stats.bytes;
+	fclose(out);
+	state = RECORDER_IDLE;
+	return ok;
+}
+
+bool recorderLoad(const char *file)
+{
+	RecorderHeader header;
+	PROS_FILE *in = fopen(file, "r");
+	bool ok;
+
+	state = RECORDER_IDLE;
+	if (in == NULL)
+		return false;
+	recorderClear();
+	ok = fread(&header, sizeof(header), 1, in) == 1 &&
+		memcmp(header.magic, RECORDER_MAGIC, sizeof(header.magic)) == 0 &&
+		header.bytes <= RECORDER_BUFFER_SIZE &&
+		fread(buffer, 1, header.bytes, in) == header.bytes;
+	fclose(in);
+	if (!ok)
+		return false;
+	stats.frames = header.frames;
+	stats.bytes = header.bytes;
+	state = RECORDER_REPLAYING;
+	return true;
+}
+
+// Decodes the next frame into previous, or leaves it centred and released at the end
+static void recorderDecode()
+{
+	unsigned char header;
+	unsigned char i;
+
+	if (repeats > 0)
+	{
+		repeats--;
+		return;
+	}
+	if (position >= stats.bytes)
+	{
+		for (i = 0; i < INPUT_AXES; i++)
+			previous.axis[i] = 0;
+		previous.buttons = 0;
+		return;
+	}
+	header = buffer[position++];
+	if (header & RECORDER_RUN)
+	{
+		repeats = header & ~RECORDER_RUN;
+		return;
+	}
+	for (i = 0; i < INPUT_AXES; i++)
+		if (header & (1 << i))
+			previous.axis[i] = (signed char)buffer[position++];
+	if (header & RECORDER_BUTTONS)
+	{
+		previous.buttons = buffer[position++];
+		previous.buttons |= (unsigned short)buffer[position++] << 8;
+	}
+}
+
+void recorderReplay(InputFrame *frame)
+{
+	unsigned long now = micros();
+	unsigned char i;
+
+	if (state == RECORDER_REPLAYING && stats.replayed < stats.frames)
+	{
+		unsigned long due;
+		unsigned long error;
+
+		if (stats.replayed == 0)
+			replayStart = now;
+		due = replayStart + stats.replayed * RECORDER_PERIOD_MS * 1000;
+		error = (long)(now - due) < 0 ? due - now : now - due;
+		if (error > stats.maxReplayError)
+			stats.maxReplayError = error;
+		recorderDecode();
+		stats.replayed++;
+	}
+	else
+	{
+		// Past the end of the recording the driver has let go of the joystick
+		for (i = 0; i < INPUT_AXES; i++)
+			previous.axis[i] = 0;
+		previous.buttons = 0;
+	}
+	for (i = 0; i < INPUT_AXES; i++)
+		frame->axis[i] = previous.axis[i];
+	frame->buttons = previous.buttons;
+}
+
+unsigned char recorderState()
+{
+	return state;
+}
+
+const RecorderStats* recorderGetStats()
+{
+	return &stats;
+}
@@ -0,0 +1,20 @@
+/** @file sensors.c
+ * @brief Per-cycle snapshot of the robot sensors
+ */
+
+#include "main.h"
+
+void sensorsSample(SensorFrame *frame)
+{
+	unsigned short digital = 0;
+	unsigned char i;
+
+	frame->time = micros();
+	frame->sorterCount = encoderGet(sorter);
+	for (i = 0; i < SENSOR_DIGITAL_PINS; i++)
+		if (digitalRead(i + 1))
+			digital |= 1 << i;
+	frame->digital = digital;
+	for (i = 0; i < SENSOR_ANALOG_CHANNELS; i++)
+		frame->analog[i] = (short)analogRead(i + 1);
+}
@@ -0,0 +1,121 @@
+/** @file shaping.c
+ * @brief Joystick response shaping
+ */
+
+#include "main.h"
+
+// Rescaling gain, in 256ths, for each stick distance from the centre; a diagonal throw reaches
+// a distance of 180, and beyond 127 the gain pulls the stick back onto the circle of radius 127
+static unsigned short gains[256];
+// Response curve of each axis, indexed by the rescaled value as an unsigned byte
+static signed char curves[INPUT_AXES][256];
+// Deadzone shape of each stick
+static unsigned char shapes[2];
+
+// Largest r with r * r <= n
+static unsigned int shapingSqrt(unsigned int n)
+{
+	unsigned int root = 0;
+	unsigned int bit = 1 << 14;
+
+	while (bit > n)
+		bit >>= 2;
+	while (bit != 0)
+	{
+		if (n >= root + bit)
+		{
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+			root >>= 1;
+		bit >>= 2;
+	}
+	return root;
+}
+
+static int shapingCurve(unsigned char curve, int value)
+{
+	// Cubic term, rounded to nearest
+	int cube = (value * value * value + (value < 0 ? -127 * 127 / 2 : 127 * 127 / 2)) /
+		(127 * 127);
+
+	switch (curve)
+	{
+	case SHAPE_EXPO:
+		return ((100 - SHAPING_EXPO_PERCENT) * value + SHAPING_EXPO_PERCENT * cube) / 100;
+	case SHAPE_CUBIC:
+		return cube;
+	default:
+		return value;
+	}
+}
+
+void shapingInit(unsigned char deadzone)
+{
+	unsigned int r;
+	unsigned char axis;
+
+	if (deadzone > 126)
+		deadzone = 126;
+	for (r = 0; r < 256; r++)
+	{
+		if (r <= deadzone)
+			gains[r] = 0;
+		else if (r >= 127)
+			gains[r] = (unsigned short)(127 * 256 / r);
+		else
+			gains[r] = (unsigned short)((r - deadzone) * 127 * 256 / ((127 - deadzone) * r));
+	}
+	for (axis = 1; axis <= INPUT_AXES; axis++)
+		shapingSetCurve(axis, SHAPE_LINEAR);
+	shapes[SHAPE_STICK_LEFT] = SHAPE_RADIAL;
+	shapes[SHAPE_STICK_RIGHT] = SHAPE_RADIAL;
+}
+
+void shapingSetDeadzoneShape(unsigned char stick, unsigned char shape)
+{
+	if (stick <= SHAPE_STICK_RIGHT)
+		shapes[stick] = shape;
+}
+
+void shapingSetCurve(unsigned char axis, unsigned char curve)
+{
+	int value;
+
+	if (axis < 1 || axis > INPUT_AXES)
+		return;
+	for (value = -128; value < 128; value++)
+		curves[axis - 1][(unsigned char)value] = (signed char)shapingCurve(curve,
+			value < -127 ? -127 : value);
+}
+
+// Applies the deadzone and the curves to the two axes of one stick
+static void shapingStick(const InputFrame *frame, unsigned char stick, unsigned char axisX,
+	unsigned char axisY, int axes[INPUT_AXES])
+{
+	int x = inputAnalog(frame, axisX);
+	int y = inputAnalog(frame, axisY);
+	unsigned int gainX, gainY;
+
+	// On one axis the distance from the centre is just the axis value
+	if (shapes[stick] == SHAPE_AXIAL)
+	{
+		gainX = gains[abs(x)];
+		gainY = gains[abs(y)];
+	}
+	else
+		gainX = gainY = gains[shapingSqrt((unsigned int)(x * x + y * y))];
+
+	// Truncating towards zero keeps both signs symmetric
+	x = x * (int)gainX / 256;
+	y = y * (int)gainY / 256;
+	axes[axisX - 1] = curves[axisX - 1][(unsigned char)x];
+	axes[axisY - 1] = curves[axisY - 1][(unsigned char)y];
+}
+
+void shapingApply(const InputFrame *frame, int axes[INPUT_AXES])
+{
+	shapingStick(frame, SHAPE_STICK_LEFT, AXIS_LEFT_X, AXIS_LEFT_Y, axes);
+	shapingStick(frame, SHAPE_STICK_RIGHT, AXIS_RIGHT_X, AXIS_RIGHT_Y, axes);
+}
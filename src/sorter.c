@@ -0,0 +1,176 @@
+/** @file sorter.c
+ * @brief Ball sorter with a FIFO of classified balls
+ */
+
+#include "main.h"
+
+typedef struct {
+	unsigned long time;
+	bool enemy;
+} SortBall;
+
+static SortBall queue[SORTER_QUEUE_SIZE];
+static unsigned int head;
+static unsigned int tail;
+
+// Ball whose stroke is in progress, valid while active is set
+static SortBall current;
+static bool active;
+// Absolute encoder position the paddle is moving to or holding
+static int target;
+static Trapezoid profile;
+// millis() when the error first came within tolerance, valid while settling is set
+static unsigned long settleStart;
+static bool settling;
+// Set when a stroke timed out, so the paddle is not pushed into the jam until the next stroke
+static bool jammed;
+
+static SorterStats stats;
+
+// Rounds an encoder count to the nearest paddle position
+static int sorterNearest(int count)
+{
+	if (count >= 0)
+		return (count + SORTER_STROKE / 2) / SORTER_STROKE * SORTER_STROKE;
+	return -((-count + SORTER_STROKE / 2) / SORTER_STROKE * SORTER_STROKE);
+}
+
+void sorterInit()
+{
+	head = 0;
+	tail = 0;
+	active = false;
+	jammed = false;
+	target = sorterNearest(encoderGet(sorter));
+	stats.depth = 0;
+	stats.maxDepth = 0;
+	stats.dropped = 0;
+	stats.sorted = 0;
+	stats.lastLatency = 0;
+	stats.maxLatency = 0;
+	stats.totalLatency = 0;
+	stats.lastSettle = 0;
+	stats.maxSettle = 0;
+	stats.timeouts = 0;
+	motorsStop(SORTER);
+}
+
+bool sorterEnqueue(bool enemy, unsigned long time)
+{
+	SortBall *ball;
+
+	if (head - tail >= SORTER_QUEUE_SIZE)
+	{
+		stats.dropped++;
+		return false;
+	}
+	ball = &queue[head & (SORTER_QUEUE_SIZE - 1)];
+	ball->enemy = enemy;
+	ball->time = time;
+	head++;
+	stats.depth = head - tail;
+	if (stats.depth > stats.maxDepth)
+		stats.maxDepth = stats.depth;
+	return true;
+}
+
+static void sorterFinish(unsigned long now)
+{
+	unsigned long latency = micros() - current.time;
+	unsigned long settle = now - profile.startTime;
+
+	active = false;
+	stats.sorted++;
+	stats.lastLatency = latency;
+	if (latency > stats.maxLatency)
+		stats.maxLatency = latency;
+	stats.totalLatency += latency;
+	stats.lastSettle = settle;
+	if (settle > stats.maxSettle)
+		stats.maxSettle = settle;
+}
+
+static int sorterClamp(int power)
+{
+	if (power > SORTER_MAX_POWER)
+		return SORTER_MAX_POWER;
+	if (power < -SORTER_MAX_POWER)
+		return -SORTER_MAX_POWER;
+	return power;
+}
+
+void sorterUpdate(const SensorFrame *sens)
+{
+	unsigned long now = millis();
+	int next;
+	int setpoint;
+	int error;
+	int power;
+
+	if (!active && head != tail)
+	{
+		current = queue[tail & (SORTER_QUEUE_SIZE - 1)];
+		tail++;
+		stats.depth = head - tail;
+		active = true;
+		settling = false;
+		jammed = false;
+		// Plan from the previous target rather than the measured position so any leftover
+		// error from the last stroke is taken out by the feedback instead of carried along
+		next = target + (current.enemy ? -SORTER_STROKE : SORTER_STROKE);
+		trapezoidPlan(&profile, target, next, SORTER_MAX_VEL, SORTER_ACCEL, now);
+		target = next;
+	}
+
+	if (!active)
+	{
+		// Hold the paddle on its target between strokes
+		error = target - sens->sorterCount;
+		if (jammed || abs(error) <= SORTER_TOLERANCE)
+			motorsStop(SORTER);
+		else
+			motorsCommand(SORTER, sorterClamp(SORTER_KP * error));
+		return;
+	}
+
+	setpoint = trapezoidPosition(&profile, now);
+	error = setpoint - sens->sorterCount;
+	power = SORTER_KP * error +
+		trapezoidVelocity(&profile, now) * SORTER_KV_NUM / SORTER_KV_DEN;
+	motorsCommand(SORTER, sorterClamp(power));
+
+	if (now - profile.startTime < trapezoidDuration(&profile))
+		return;
+	if (abs(target - sens->sorterCount) > SORTER_TOLERANCE)
+	{
+		settling = false;
+		if (now - profile.startTime >= trapezoidDuration(&profile) + SORTER_TIMEOUT_MS)
+		{
+			// Abandon the stroke without counting the ball as sorted. The next stroke is
+			// planned from wherever the paddle stopped rather than from the position it
+			// never reached
+			active = false;
+			jammed = true;
+			target = sorterNearest(sens->sorterCount);
+			stats.timeouts++;
+			motorsStop(SORTER);
+		}
+	}
+	else if (!settling)
+	{
+		settling = true;
+		settleStart = now;
+	}
+	else if (now - settleStart >= SORTER_SETTLE_MS)
+		sorterFinish(settleStart);
+}
+
+bool sorterIdle()
+{
+	return !active && head == tail;
+}
+
+const SorterStats* sorterGetStats()
+{
+	return &stats;
+}
@@ -0,0 +1,148 @@
+/** @file telemetry.c
+ * @brief Non-blocking binary telemetry
+ */
+
+#include "main.h"
+#include "wire.h"
+
+// Bounded multi-producer queue after Vyukov: a slot whose seq equals the position being pushed
+// is free, and one whose seq is position + 1 holds a record ready to pop
+typedef struct {
+	volatile uint32_t seq;
+	TelemetryRecord record;
+} TelemetrySlot;
+
+static TelemetrySlot queue[TELEMETRY_QUEUE_SIZE];
+// Both positions count forever and are masked on access
+static uint32_t head;
+static uint32_t tail;
+static volatile uint32_t overflows;
+
+static void (*volatile sampler)();
+static TaskHandle telemetryHandle;
+LoopTimer telemetryTimer;
+
+// Single-character commands from the driver station: 'p' dumps the profiler, 'r' resets it
+static void telemetryCommands()
+{
+	while (fcount(stdin) > 0)
+	{
+		switch (fgetc(stdin))
+		{
+		case 'p':
+			profDump();
+			break;
+		case 'r':
+			profReset();
+			break;
+		}
+	}
+}
+
+static void telemetryTask(void *ignore)
+{
+	TelemetryRecord record;
+	uint8_t buf[TELEMETRY_DRAIN_BATCH * WIRE_FRAME_MAX];
+	uint8_t seq = 0;
+
+	loopTimerInit(&telemetryTimer, TELEMETRY_PERIOD_MS);
+	while (1)
+	{
+		void (*sample)() = sampler;
+		size_t len = 0;
+		unsigned int frames = 0;
+
+		loopTimerBegin(&telemetryTimer);
+		telemetryCommands();
+		if (sample != NULL)
+			sample();
+		PROF_BEGIN(PROF_TELEMETRY);
+		while (telemetryPop(&record))
+		{
+			len += wireEncodeFrame(seq++, &record, &buf[len]);
+			if (++frames == TELEMETRY_DRAIN_BATCH)
+			{
+				fwrite(buf, 1, len, stdout);
+				len = 0;
+				frames = 0;
+			}
+		}
+		if (len > 0)
+			fwrite(buf, 1, len, stdout);
+		PROF_END(PROF_TELEMETRY);
+		loopTimerWait(&telemetryTimer);
+	}
+}
+
+void telemetryInit()
+{
+	uint32_t i;
+
+	for (i = 0; i < TELEMETRY_QUEUE_SIZE; i++)
+		queue[i].seq = i;
+	head = 0;
+	tail = 0;
+	overflows = 0;
+	if (telemetryHandle == NULL)
+		telemetryHandle = taskCreate(telemetryTask, TASK_DEFAULT_STACK_SIZE, NULL,
+			TASK_PRIORITY_LOWEST);
+}
+
+void telemetrySetSampler(void (*fn)())
+{
+	sampler = fn;
+}
+
+bool telemetryPush(uint8_t type, uint8_t channel, int32_t value)
+{
+	uint32_t pos = __atomic_load_n(&head, __ATOMIC_RELAXED);
+	TelemetrySlot *slot;
+
+	while (1)
+	{
+		int32_t diff;
+
+		slot = &queue[pos & (TELEMETRY_QUEUE_SIZE - 1)];
+		diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+		if (diff == 0)
+		{
+			// Slot is free; claim it, or retry from wherever the winning producer left head
+			if (__atomic_compare_exchange_n(&head, &pos, pos + 1, true, __ATOMIC_RELAXED,
+					__ATOMIC_RELAXED))
+				break;
+		}
+		else if (diff < 0)
+		{
+			// The consumer has not released this slot yet, so the queue is full
+			__atomic_add_fetch(&overflows, 1, __ATOMIC_RELAXED);
+			return false;
+		}
+		else
+			pos = __atomic_load_n(&head, __ATOMIC_RELAXED);
+	}
+	slot->record.time = millis();
+	slot->record.type = type;
+	slot->record.channel = channel;
+	slot->record.value = value;
+	// Publish the record only after it is completely written
+	__atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+bool telemetryPop(TelemetryRecord *record)
+{
+	TelemetrySlot *slot = &queue[tail & (TELEMETRY_QUEUE_SIZE - 1)];
+
+	if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != tail + 1)
+		return false;
+	*record = slot->record;
+	// Release the slot for the producer one lap ahead only after it has been copied out
+	__atomic_store_n(&slot->seq, tail + TELEMETRY_QUEUE_SIZE, __ATOMIC_RELEASE);
+	tail++;
+	return true;
+}
+
+uint32_t telemetryOverflows()
+{
+	return overflows;
+}
@@ -0,0 +1,161 @@
+/** @file trajectory.c
+ * @brief Playback of precomputed drive trajectories
+ */
+
+#include "main.h"
+
+// Table being played, or NULL when running a planned move or idle
+static const Trajectory *active;
+// Planned move: a profile on the wheel that travels furthest, and each wheel's signed travel
+static bool moving;
+static Trapezoid profile;
+static int travel[DRIVE_WHEELS];
+// Index of the next step to run
+static unsigned short next;
+// IME count of each wheel when the trajectory started, and its planned travel since, in
+// milliticks
+static int origin[DRIVE_WHEELS];
+static long long planned[DRIVE_WHEELS];
+
+static TrajectoryStats stats;
+
+static void trajectoryReset()
+{
+	unsigned char i;
+
+	next = 0;
+	for (i = 0; i < DRIVE_WHEELS; i++)
+	{
+		if (!driveGetPosition(i, &origin[i]))
+			origin[i] = 0;
+		planned[i] = 0;
+	}
+	stats.steps = 0;
+	stats.maxError = 0;
+	stats.totalError = 0;
+	stats.finalError = 0;
+	stats.imeFailures = 0;
+}
+
+void trajectoryStart(const Trajectory *trajectory)
+{
+	active = trajectory;
+	moving = false;
+	trajectoryReset();
+}
+
+void trajectoryStartMove(int forward, int strafe, int turn, unsigned int maxVel,
+	unsigned int accel)
+{
+	int distance = 0;
+	unsigned char i;
+
+	// Same wheel signs as driveMix()
+	travel[DRIVE_FRONT_LEFT] = 0 - turn - forward + strafe;
+	travel[DRIVE_FRONT_RIGHT] = 0 - turn + forward + strafe;
+	travel[DRIVE_BACK_LEFT] = 0 - turn - forward - strafe;
+	travel[DRIVE_BACK_RIGHT] = 0 - turn + forward - strafe;
+	for (i = 0; i < DRIVE_WHEELS; i++)
+		if (abs(travel[i]) > distance)
+			distance = abs(travel[i]);
+	trapezoidPlan(&profile, 0, distance, maxVel, accel, 0);
+	active = NULL;
+	moving = true;
+	trajectoryReset();
+}
+
+bool trajectoryActive()
+{
+	return active != NULL || moving;
+}
+
+bool trajectoryStep()
+{
+	int powers[DRIVE_WHEELS];
+	unsigned long worst = 0;
+	unsigned long t = (unsigned long)next * TRAJECTORY_PERIOD_MS;
+	bool done;
+	unsigned char i;
+
+	if (active == NULL && !moving)
+	{
+		driveStop();
+		return false;
+	}
+	// One step past the last point only measures where the wheels ended up
+	if (active != NULL)
+		done = next >= active->length;
+	else
+		done = t >= trapezoidDuration(&profile);
+	for (i = 0; i < DRIVE_WHEELS; i++)
+	{
+		int velocity;
+		int ticks;
+
+		if (active != NULL)
+			velocity = done ? 0 : active->points[next].velocity[i];
+		else
+		{
+			// The lead wheel follows the profile and the others keep in proportion to it
+			velocity = done || profile.distance == 0 ? 0 :
+				(int)((long long)trapezoidVelocity(&profile, t) * travel[i] / profile.distance);
+			planned[i] = profile.distance == 0 ? 0 :
+				(long long)trapezoidPosition(&profile, t) * travel[i] * 1000 / profile.distance;
+		}
+		powers[i] = velocity * DRIVE_MAX_POWER / DRIVE_FREE_SPEED;
+		// The error is measured against where the wheel should be now, before this step moves
+		// the setpoint on
+		if (driveGetPosition(i, &ticks))
+		{
+			int error = (int)(planned[i] / 1000) - (ticks - origin[i]);
+
+			powers[i] += error * TRAJECTORY_KP_NUM / TRAJECTORY_KP_DEN;
+			if ((unsigned long)abs(error) > worst)
+				worst = abs(error);
+		}
+		else
+			stats.imeFailures++;
+		if (active != NULL)
+			planned[i] += (long long)velocity * TRAJECTORY_PERIOD_MS;
+	}
+	if (done)
+	{
+		stats.finalError = worst;
+		active = NULL;
+		moving = false;
+		driveStop();
+		return false;
+	}
+	next++;
+	driveWheels(powers);
+	stats.steps++;
+	stats.totalError += worst;
+	if (worst > stats.maxError)
+		stats.maxError = worst;
+	telemetryPush(TELEM_TRAJECTORY, TELEM_TRAJECTORY_ERROR, (int32_t)worst);
+	return true;
+}
+
+void trajectoryRun(const Trajectory *trajectory)
+{
+	LoopTimer timer;
+
+	trajectoryStart(trajectory);
+	loopTimerInit(&timer, TRAJECTORY_PERIOD_MS);
+	while (1)
+	{
+		bool running;
+
+		loopTimerBegin(&timer);
+		running = trajectoryStep();
+		motorsFlushPorts(DRIVE_PORTS);
+		if (!running)
+			break;
+		loopTimerWait(&timer);
+	}
+}
+
+const TrajectoryStats* trajectoryGetStats()
+{
+	return &stats;
+}
@@ -0,0 +1,110 @@
+/** @file trapezoid.c
+ * @brief Trapezoidal velocity profiles in integer arithmetic
+ */
+
+#include "main.h"
+
+static unsigned long isqrt(unsigned long long n)
+{
+	unsigned long long root = 0;
+	unsigned long long bit = 1ULL << 62;
+
+	while (bit > n)
+		bit >>= 2;
+	while (bit != 0)
+	{
+		if (n >= root + bit)
+		{
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+			root >>= 1;
+		bit >>= 2;
+	}
+	return (unsigned long)root;
+}
+
+void trapezoidPlan(Trapezoid *profile, int from, int to, unsigned int maxVel,
+	unsigned int accel, unsigned long startTime)
+{
+	unsigned long long distance = to >= from ? to - from : from - to;
+	unsigned long long accelDistance;
+	unsigned long long cruiseDistance;
+
+	profile->start = from;
+	profile->distance = (int)distance;
+	profile->direction = to >= from ? 1 : -1;
+	profile->accel = accel;
+	profile->startTime = startTime;
+
+	// Distance covered accelerating to maxVel, in ticks * 2 * accel to stay in integers
+	accelDistance = (unsigned long long)maxVel * maxVel;
+	if (2 * accelDistance >= distance * 2 * accel)
+	{
+		// Triangular: accelerate for half the distance, then decelerate
+		profile->peakVel = isqrt(distance * accel);
+		profile->cruiseTime = 0;
+	}
+	else
+	{
+		profile->peakVel = maxVel;
+		cruiseDistance = distance - accelDistance / accel;
+		profile->cruiseTime = (unsigned long)(cruiseDistance * 1000 / maxVel);
+	}
+	profile->accelTime = (unsigned long)((unsigned long long)profile->peakVel * 1000 / accel);
+}
+
+unsigned long trapezoidDuration(const Trapezoid *profile)
+{
+	return 2 * profile->accelTime + profile->cruiseTime;
+}
+
+// Distance travelled t ms into the acceleration phase
+static unsigned long long accelTravel(const Trapezoid *profile, unsigned long t)
+{
+	return (unsigned long long)profile->accel * t * t / 2000000;
+}
+
+int trapezoidPosition(const Trapezoid *profile, unsigned long now)
+{
+	unsigned long t = now - profile->startTime;
+	unsigned long total = trapezoidDuration(profile);
+	unsigned long long travel;
+
+	if ((long)(now - profile->startTime) < 0)
+		return profile->start;
+	if (t >= total)
+		travel = profile->distance;
+	else if (t < profile->accelTime)
+		travel = accelTravel(profile, t);
+	else if (t < profile->accelTime + profile->cruiseTime)
+		travel = accelTravel(profile, profile->accelTime) +
+			(unsigned long long)profile->peakVel * (t - profile->accelTime) / 1000;
+	else
+	{
+		// Mirror of the acceleration phase, measured back from the end of the move
+		travel = accelTravel(profile, total - t);
+		travel = travel < (unsigned long long)profile->distance ? profile->distance - travel : 0;
+	}
+	if (travel > (unsigned long long)profile->distance)
+		travel = profile->distance;
+	return profile->start + profile->direction * (int)travel;
+}
+
+int trapezoidVelocity(const Trapezoid *profile, unsigned long now)
+{
+	unsigned long t = now - profile->startTime;
+	unsigned long total = trapezoidDuration(profile);
+	unsigned long v;
+
+	if ((long)(now - profile->startTime) < 0 || t >= total)
+		return 0;
+	if (t < profile->accelTime)
+		v = (unsigned long long)profile->accel * t / 1000;
+	else if (t < profile->accelTime + profile->cruiseTime)
+		v = profile->peakVel;
+	else
+		v = (unsigned long long)profile->accel * (total - t) / 1000;
+	return profile->direction * (int)v;
+}
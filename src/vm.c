@@ -0,0 +1,316 @@
+/** @file vm.c
+ * @brief Bytecode interpreter for autonomous routines
+ */
+
+#include "main.h"
+#include <string.h>
+
+// Limits for moves before the program sets its own, the same as tools/mktraj.c
+#define VM_DEFAULT_VEL 800
+#define VM_DEFAULT_ACCEL 1600
+
+typedef struct {
+	char magic[4];
+	unsigned short length;
+} VmHeader;
+
+typedef struct {
+	// Address of the instruction being run
+	unsigned short pc;
+	bool live;
+	// Set once a waiting instruction has started its wait
+	bool waiting;
+	// millis() when a WAIT ends or a sensor wait times out
+	unsigned long until;
+} VmThread;
+
+// Length of each instruction, by opcode
+static const unsigned char lengths[VM_OPCODES] = {
+	[VM_END] = 1,
+	[VM_DRIVE] = 3,
+	[VM_STRAFE] = 3,
+	[VM_TURN] = 3,
+	[VM_LIMITS] = 5,
+	[VM_MOTOR] = 3,
+	[VM_WAIT] = 3,
+	[VM_WAITPIN] = 5,
+	[VM_WAITABOVE] = 6,
+	[VM_WAITBELOW] = 6,
+	[VM_PARALLEL] = 3,
+	[VM_JOIN] = 1
+};
+
+static unsigned char program[VM_PROGRAM_SIZE];
+static unsigned short length;
+static VmThread threads[VM_THREADS];
+static unsigned int maxVel;
+static unsigned int accel;
+// Thread whose move trajectoryStartMove() last started, so it waits for its own move only
+static VmThread *mover;
+
+static VmStats stats;
+
+static inline unsigned int vmU16(unsigned short address)
+{
+	return program[address] | ((unsigned int)program[address + 1] << 8);
+}
+
+static inline int vmI16(unsigned short address)
+{
+	return (short)vmU16(address);
+}
+
+// Checks every instruction once so that running the program needs no checks: each opcode is
+// known and complete, operands are in range, forks go forward to the start of an instruction,
+// the last instruction is END, so every thread reaches an END, and no forked thread joins, so
+// JOIN cannot deadlock
+static bool vmCheck()
+{
+	static unsigned char starts[VM_PROGRAM_SIZE / 8];
+	unsigned short pc = 0;
+	unsigned char op = VM_JOIN;
+
+	memset(starts, 0, sizeof(starts));
+	while (pc < length)
+	{
+		unsigned char arg;
+
+		op = program[pc];
+		if (op >= VM_OPCODES || pc + lengths[op] > length)
+			return false;
+		// The first operand byte, for the opcodes that have one
+		arg = lengths[op] > 1 ? program[pc + 1] : 0;
+		switch (op)
+		{
+		case VM_LIMITS:
+			if (vmU16(pc + 1) == 0 || vmU16(pc + 3) == 0)
+				return false;
+			break;
+		case VM_MOTOR:
+			if (arg < 1 || arg > MOTOR_PORTS || (DRIVE_PORTS & MOTOR_PORT_MASK(arg)) ||
+				(signed char)program[pc + 2] < -127)
+				return false;
+			break;
+		case VM_WAITPIN:
+			if (arg < 1 || arg > SENSOR_DIGITAL_PINS || program[pc + 2] > 1)
+				return false;
+			break;
+		case VM_WAITABOVE:
+		case VM_WAITBELOW:
+			if (arg < 1 || arg > SENSOR_ANALOG_CHANNELS)
+				return false;
+			break;
+		case VM_PARALLEL:
+			if (vmU16(pc + 1) <= pc || vmU16(pc + 1) >= length)
+				return false;
+			break;
+		}
+		starts[pc / 8] |= 1 << (pc % 8);
+		pc += lengths[op];
+	}
+	if (op != VM_END)
+		return false;
+	for (pc = 0; pc < length; pc += lengths[program[pc]])
+		if (program[pc] == VM_PARALLEL)
+		{
+			unsigned int target = vmU16(pc + 1);
+
+			if (!(starts[target / 8] & (1 << (target % 8))))
+				return false;
+			// The forked thread runs from its target to the next END
+			for (; program[target] != VM_END; target += lengths[program[target]])
+				if (program[target] == VM_JOIN)
+					return false;
+		}
+	return true;
+}
+
+bool vmLoad(const char *file)
+{
+	VmHeader header;
+	PROS_FILE *in = fopen(file, "r");
+	bool ok;
+
+	length = 0;
+	if (in == NULL)
+		return false;
+	ok = fread(&header, sizeof(header), 1, in) == 1 &&
+		memcmp(header.magic, VM_MAGIC, sizeof(header.magic)) == 0 &&
+		header.length > 0 && header.length <= VM_PROGRAM_SIZE &&
+		fread(program, 1, header.length, in) == header.length;
+	fclose(in);
+	if (!ok)
+		return false;
+	length = header.length;
+	if (!vmCheck())
+		length = 0;
+	return length > 0;
+}
+
+bool vmLoaded()
+{
+	return length > 0;
+}
+
+void vmStart()
+{
+	unsigned char i;
+
+	for (i = 0; i < VM_THREADS; i++)
+		threads[i].live = false;
+	threads[0].pc = 0;
+	threads[0].live = length > 0;
+	threads[0].waiting = false;
+	maxVel = VM_DEFAULT_VEL;
+	accel = VM_DEFAULT_ACCEL;
+	mover = NULL;
+	memset(&stats, 0, sizeof(stats));
+}
+
+// Starts a wait that ends at now + ms, or checks whether it has ended
+static bool vmWaitFor(VmThread *thread, unsigned long now, unsigned int ms)
+{
+	if (!thread->waiting)
+	{
+		thread->waiting = true;
+		thread->until = now + ms;
+	}
+	return (long)(now - thread->until) >= 0;
+}
+
+// Runs one thread until it waits, ends or uses up its budget; returns the instructions executed
+static unsigned long vmRunThread(VmThread *thread, const SensorFrame *frame, unsigned long now)
+{
+	unsigned long executed = 0;
+
+	while (thread->live && executed < VM_TICK_BUDGET)
+	{
+		const unsigned short pc = thread->pc;
+		const unsigned char op = program[pc];
+		bool done = true;
+		unsigned char i;
+
+		switch (op)
+		{
+		case VM_END:
+			thread->live = false;
+			break;
+		case VM_DRIVE:
+		case VM_STRAFE:
+		case VM_TURN:
+			// Start once any other move has finished, then wait for this one. Another thread
+			// may start its move in the tick this one finishes, so a move that is no longer
+			// this thread's has finished too.
+			if (!thread->waiting)
+			{
+				if (trajectoryActive())
+					return executed;
+				trajectoryStartMove(op == VM_DRIVE ? vmI16(pc + 1) : 0,
+					op == VM_STRAFE ? vmI16(pc + 1) : 0, op == VM_TURN ? vmI16(pc + 1) : 0,
+					maxVel, accel);
+				mover = thread;
+				thread->waiting = true;
+			}
+			done = mover != thread || !trajectoryActive();
+			break;
+		case VM_LIMITS:
+			maxVel = vmU16(pc + 1);
+			accel = vmU16(pc + 3);
+			break;
+		case VM_MOTOR:
+			motorsCommand(program[pc + 1], (signed char)program[pc + 2]);
+			break;
+		case VM_WAIT:
+			done = vmWaitFor(thread, now, vmU16(pc + 1));
+			break;
+		case VM_WAITPIN:
+		case VM_WAITABOVE:
+		case VM_WAITBELOW:
+			if (op == VM_WAITPIN)
+				done = sensorDigital(frame, program[pc + 1]) == program[pc + 2];
+			else if (op == VM_WAITABOVE)
+				done = sensorAnalog(frame, program[pc + 1]) > (int)vmU16(pc + 2);
+			else
+				done = sensorAnalog(frame, program[pc + 1]) < (int)vmU16(pc + 2);
+			if (!done && vmWaitFor(thread, now, vmU16(pc + lengths[op] - 2)))
+			{
+				stats.timeouts++;
+				done = true;
+			}
+			break;
+		case VM_PARALLEL:
+			// Wait for a free thread
+			done = false;
+			for (i = 0; i < VM_THREADS && !done; i++)
+				if (!threads[i].live)
+				{
+					threads[i].pc = vmU16(pc + 1);
+					threads[i].live = true;
+					threads[i].waiting = false;
+					done = true;
+				}
+			break;
+		case VM_JOIN:
+			for (i = 0; i < VM_THREADS; i++)
+				if (threads[i].live && &threads[i] != thread)
+					done = false;
+			break;
+		}
+		if (!done)
+			return executed;
+		thread->pc = pc + lengths[op];
+		thread->waiting = false;
+		stats.executed[op]++;
+		executed++;
+	}
+	return executed;
+}
+
+bool vmTick(const SensorFrame *frame)
+{
+	unsigned long now = millis();
+	unsigned long executed = 0;
+	bool running = false;
+	unsigned char i;
+
+	PROF_BEGIN(PROF_VM);
+	// A thread forked into a later slot starts in the same tick, one in an earlier slot next tick
+	for (i = 0; i < VM_THREADS; i++)
+		executed += vmRunThread(&threads[i], frame, now);
+	PROF_END(PROF_VM);
+	for (i = 0; i < VM_THREADS; i++)
+		running = running || threads[i].live;
+	stats.ticks++;
+	stats.instructions += executed;
+	if (executed > stats.maxPerTick)
+		stats.maxPerTick = executed;
+	return running;
+}
+
+void vmRun()
+{
+	LoopTimer timer;
+	SensorFrame frame;
+
+	vmStart();
+	loopTimerInit(&timer, DRIVE_PERIOD_MS);
+	while (1)
+	{
+		bool running;
+
+		loopTimerBegin(&timer);
+		sensorsSample(&frame);
+		running = vmTick(&frame);
+		trajectoryStep();
+		powerUpdate();
+		motorsFlush();
+		if (!running)
+			break;
+		loopTimerWait(&timer);
+	}
+}
+
+const VmStats* vmGetStats()
+{
+	return &stats;
+}
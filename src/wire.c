@@ -0,0 +1,129 @@
+/** @file wire.c
+ * @brief Framed, checksummed telemetry wire format
+ *
+ * Only includes wire.h (not main.h) so the host-side decoder can build it without API.h.
+ */
+
+#include "wire.h"
+
+// CRC-16/CCITT-FALSE remainders for each 4-bit value, processed a nibble at a time to keep
+// the table at 32 bytes of flash
+static const uint16_t crcNibble[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t wireCrc16(const uint8_t *data, size_t len)
+{
+	uint16_t crc = 0xFFFF;
+
+	while (len--)
+	{
+		crc ^= (uint16_t)(*data++) << 8;
+		crc = (crc << 4) ^ crcNibble[crc >> 12];
+		crc = (crc << 4) ^ crcNibble[crc >> 12];
+	}
+	return crc;
+}
+
+size_t wireCobsEncode(const uint8_t *in, size_t len, uint8_t *out)
+{
+	size_t codeIndex = 0;
+	size_t o = 1;
+	uint8_t code = 1;
+	size_t i;
+
+	for (i = 0; i < len; i++)
+	{
+		if (in[i] == 0)
+		{
+			out[codeIndex] = code;
+			codeIndex = o++;
+			code = 1;
+		}
+		else
+		{
+			out[o++] = in[i];
+			code++;
+		}
+	}
+	out[codeIndex] = code;
+	return o;
+}
+
+size_t wireCobsDecode(const uint8_t *in, size_t len, uint8_t *out)
+{
+	size_t i = 0;
+	size_t o = 0;
+
+	while (i < len)
+	{
+		uint8_t code = in[i++];
+		uint8_t j;
+
+		if (code == 0 || i + code - 1 > len)
+			return 0;
+		for (j = 1; j < code; j++)
+		{
+			if (in[i] == 0)
+				return 0;
+			out[o++] = in[i++];
+		}
+		// Every group except the last one stands for a zero in the original data
+		if (i < len)
+			out[o++] = 0;
+	}
+	return o;
+}
+
+static void putLe32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t getLe32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+size_t wireEncodeFrame(uint8_t seq, const TelemetryRecord *record, uint8_t *out)
+{
+	uint8_t payload[WIRE_PAYLOAD_SIZE];
+	uint16_t crc;
+	size_t len;
+
+	payload[0] = seq;
+	putLe32(&payload[1], record->time);
+	payload[5] = record->type;
+	payload[6] = record->channel;
+	putLe32(&payload[7], (uint32_t)record->value);
+	crc = wireCrc16(payload, WIRE_PAYLOAD_SIZE - 2);
+	payload[11] = (uint8_t)crc;
+	payload[12] = (uint8_t)(crc >> 8);
+
+	len = wireCobsEncode(payload, WIRE_PAYLOAD_SIZE, out);
+	out[len++] = 0;
+	return len;
+}
+
+bool wireDecodeFrame(const uint8_t *frame, size_t len, uint8_t *seq, TelemetryRecord *record)
+{
+	uint8_t payload[WIRE_FRAME_MAX];
+	uint16_t crc;
+
+	if (len > WIRE_FRAME_MAX || wireCobsDecode(frame, len, payload) != WIRE_PAYLOAD_SIZE)
+		return false;
+	crc = payload[11] | (payload[12] << 8);
+	if (wireCrc16(payload, WIRE_PAYLOAD_SIZE - 2) != crc)
+		return false;
+
+	*seq = payload[0];
+	record->time = getLe32(&payload[1]);
+	record->type = payload[5];
+	record->channel = payload[6];
+	record->value = (int32_t)getLe32(&payload[7]);
+	return true;
+}
@@ -0,0 +1,121 @@
+/** @file looptimer.c
+ * @brief Host unit test of the loop timer's schedule and statistics
+ *
+ * millis(), micros() and taskDelayUntil() are stubbed on a clock the test advances by hand, so
+ * every cycle's work takes exactly the time a case asks for.
+ */
+
+#include "main.h"
+#include "test.h"
+
+#define PERIOD_MS 10
+#define CYCLES 100
+
+// Virtual time in microseconds
+static unsigned long now;
+
+unsigned long micros()
+{
+	return now;
+}
+
+unsigned long millis()
+{
+	return now / 1000;
+}
+
+// Sleeps until the next wake time, or returns at once if it has passed, as FreeRTOS does
+void taskDelayUntil(unsigned long *previousWakeTime, const unsigned long cycleTime)
+{
+	*previousWakeTime += cycleTime;
+	if (now < *previousWakeTime * 1000)
+		now = *previousWakeTime * 1000;
+}
+
+// Runs cycles whose work takes work(i) microseconds and checks that every cycle starts on the
+// schedule laid down at init, whatever the cycles before it overran
+static void testSchedule(unsigned long start, unsigned long (*work)(int),
+	unsigned long expectedOverruns)
+{
+	LoopTimer timer;
+	int i;
+
+	now = start;
+	loopTimerInit(&timer, PERIOD_MS);
+	for (i = 0; i < CYCLES; i++)
+	{
+		loopTimerBegin(&timer);
+		CHECK_EQUAL((now - start) % (PERIOD_MS * 1000), 0);
+		now += work(i);
+		loopTimerWait(&timer);
+	}
+	CHECK_EQUAL(timer.cycles, CYCLES);
+	CHECK_EQUAL(timer.overruns, expectedOverruns);
+}
+
+static unsigned long workShort(int i)
+{
+	return 3500;
+}
+
+static unsigned long workFullPeriod(int i)
+{
+	return PERIOD_MS * 1000;
+}
+
+static unsigned long workOverrun(int i)
+{
+	if (i == 10)
+		return 15000;
+	if (i == 20)
+		return 25000;
+	return 2000;
+}
+
+int main()
+{
+	LoopTimer timer;
+	unsigned long start;
+
+	// No drift: 100 cycles of short work take exactly 100 periods
+	testSchedule(5000, workShort, 0);
+	CHECK_EQUAL(now, 5000 + CYCLES * PERIOD_MS * 1000);
+
+	// Work that ends exactly on the next wake time has not missed it
+	testSchedule(0, workFullPeriod, 0);
+	CHECK_EQUAL(now, CYCLES * PERIOD_MS * 1000);
+
+	// A 15 ms cycle skips one slot and a 25 ms cycle two, keeping the phase
+	testSchedule(0, workOverrun, 2);
+	CHECK_EQUAL(now, (CYCLES + 1 + 2) * PERIOD_MS * 1000);
+
+	// Period, execution and CPU share statistics
+	now = 1000;
+	start = now;
+	loopTimerInit(&timer, PERIOD_MS);
+	loopTimerBegin(&timer);
+	now += 3000;
+	loopTimerWait(&timer);
+	CHECK_EQUAL(loopTimerJitter(&timer), 0);
+	loopTimerBegin(&timer);
+	now += 15000;
+	loopTimerWait(&timer);
+	loopTimerBegin(&timer);
+	now += 3000;
+	loopTimerWait(&timer);
+	loopTimerBegin(&timer);
+	CHECK_EQUAL(now - start, 40000);
+	CHECK_EQUAL(timer.minPeriod, 10000);
+	CHECK_EQUAL(timer.maxPeriod, 20000);
+	CHECK_EQUAL(timer.lastPeriod, 10000);
+	CHECK_EQUAL(loopTimerJitter(&timer), 10000);
+	CHECK_EQUAL(timer.maxExec, 15000);
+	CHECK_EQUAL(loopTimerMeanExec(&timer), 7000);
+	// 7 ms of a 10 ms period is 70.0%
+	CHECK_EQUAL(loopTimerCpuShare(&timer), 700);
+	loopTimerResetStats(&timer);
+	CHECK_EQUAL(timer.cycles, 0);
+	CHECK_EQUAL(loopTimerMeanExec(&timer), 0);
+
+	return testFinish("looptimer");
+}
@@ -0,0 +1,141 @@
+/** @file shaping.c
+ * @brief Host unit test of the joystick deadzone and response curves
+ *
+ * Frames are built by hand and shaped with the deadzone operatorControl() uses. A continuous
+ * deadzone edge means the output leaves 0 one step at a time: ±1 on the first stick distance
+ * past the edge, and beyond it no larger steps than the rescaling and the curve's own slope
+ * give.
+ */
+
+#include "main.h"
+#include "test.h"
+#include <stdlib.h>
+#include <string.h>
+
+// The deadzone set by operatorControl()
+#define DEADZONE 20
+
+static const unsigned char curves[] = { SHAPE_LINEAR, SHAPE_EXPO, SHAPE_CUBIC };
+// Largest output step of each curve for a stick step of 1 past the deadzone. The rescaling
+// slope of 127 / (127 - DEADZONE) moves the rescaled value by 1 or 2, and the curve multiplies
+// that by its steepest slope: 1, 2.2 and 3 at full throw.
+static const int maxSteps[] = { 2, 5, 6 };
+
+// Shapes a frame with the left stick at (x, y) and the right stick at (turn, 0)
+static void shape(int x, int y, int turn, int axes[INPUT_AXES])
+{
+	InputFrame frame;
+
+	memset(&frame, 0, sizeof(frame));
+	frame.axis[AXIS_LEFT_X - 1] = (signed char)x;
+	frame.axis[AXIS_LEFT_Y - 1] = (signed char)y;
+	frame.axis[AXIS_RIGHT_X - 1] = (signed char)turn;
+	shapingApply(&frame, axes);
+}
+
+static void setCurves(unsigned char curve)
+{
+	unsigned char axis;
+
+	for (axis = 1; axis <= INPUT_AXES; axis++)
+		shapingSetCurve(axis, curve);
+}
+
+int main()
+{
+	int axes[INPUT_AXES];
+	int v, x, y, last;
+	unsigned int i;
+	unsigned int jumps = 0;
+	unsigned int asymmetric = 0;
+	unsigned int unbounded = 0;
+
+	// At the edge of the radial deadzone the stick is still centred, whatever its direction
+	shapingInit(DEADZONE);
+	shape(DEADZONE, 0, 0, axes);
+	CHECK_EQUAL(axes[AXIS_LEFT_X - 1], 0);
+	shape(0, -DEADZONE, 0, axes);
+	CHECK_EQUAL(axes[AXIS_LEFT_Y - 1], 0);
+	shape(12, 16, 0, axes);
+	CHECK_EQUAL(axes[AXIS_LEFT_X - 1], 0);
+	CHECK_EQUAL(axes[AXIS_LEFT_Y - 1], 0);
+
+	// One step past it the output is ±1, not the jump to ±21 of a deadzone that just cuts off
+	shape(DEADZONE + 1, 0, 0, axes);
+	CHECK_EQUAL(axes[AXIS_LEFT_X - 1], 1);
+	shape(-(DEADZONE + 1), 0, 0, axes);
+	CHECK_EQUAL(axes[AXIS_LEFT_X - 1], -1);
+	shape(0, DEADZONE + 1, 0, axes);
+	CHECK_EQUAL(axes[AXIS_LEFT_Y - 1], 1);
+	shape(0, -(DEADZONE + 1), 0, axes);
+	CHECK_EQUAL(axes[AXIS_LEFT_Y - 1], -1);
+	shape(15, 15, 0, axes);
+	CHECK(abs(axes[AXIS_LEFT_X - 1]) <= 1 && abs(axes[AXIS_LEFT_Y - 1]) <= 1);
+
+	// The same on an axial stick, whose deadzone applies to each axis on its own
+	shapingSetDeadzoneShape(SHAPE_STICK_RIGHT, SHAPE_AXIAL);
+	shape(0, 0, DEADZONE, axes);
+	CHECK_EQUAL(axes[AXIS_RIGHT_X - 1], 0);
+	shape(0, 0, DEADZONE + 1, axes);
+	CHECK_EQUAL(axes[AXIS_RIGHT_X - 1], 1);
+	shape(0, 0, -(DEADZONE + 1), axes);
+	CHECK_EQUAL(axes[AXIS_RIGHT_X - 1], -1);
+
+	// Past the edge every curve rises steadily to full scale, without a jump anywhere
+	for (i = 0; i < sizeof(curves); i++)
+	{
+		shapingInit(DEADZONE);
+		shapingSetDeadzoneShape(SHAPE_STICK_RIGHT, SHAPE_AXIAL);
+		setCurves(curves[i]);
+		last = 0;
+		for (v = 0; v <= 127; v++)
+		{
+			shape(v, 0, v, axes);
+			if (axes[AXIS_LEFT_X - 1] < last || axes[AXIS_LEFT_X - 1] - last > maxSteps[i] ||
+				axes[AXIS_RIGHT_X - 1] != axes[AXIS_LEFT_X - 1])
+				jumps++;
+			last = axes[AXIS_LEFT_X - 1];
+		}
+		CHECK_EQUAL(last, 127);
+	}
+	CHECK_EQUAL(jumps, 0);
+
+	// With no deadzone the axes reach the curve tables unchanged, so every table can be read
+	// whole: each is odd and within ±127
+	for (i = 0; i < sizeof(curves); i++)
+	{
+		shapingInit(0);
+		setCurves(curves[i]);
+		for (v = 0; v <= 127; v++)
+		{
+			int positive;
+
+			shape(v, 0, 0, axes);
+			positive = axes[AXIS_LEFT_X - 1];
+			shape(-v, 0, 0, axes);
+			if (axes[AXIS_LEFT_X - 1] != -positive)
+				asymmetric++;
+			if (abs(positive) > 127)
+				unbounded++;
+		}
+	}
+	CHECK_EQUAL(asymmetric, 0);
+
+	// Every stick position, diagonals included, gives outputs within ±127 on every curve
+	for (i = 0; i < sizeof(curves); i++)
+	{
+		shapingInit(DEADZONE);
+		setCurves(curves[i]);
+		for (x = -128; x <= 127; x++)
+			for (y = -128; y <= 127; y++)
+			{
+				shape(x, y, x, axes);
+				if (abs(axes[AXIS_LEFT_X - 1]) > 127 || abs(axes[AXIS_LEFT_Y - 1]) > 127 ||
+					abs(axes[AXIS_RIGHT_X - 1]) > 127)
+					unbounded++;
+			}
+	}
+	CHECK_EQUAL(unbounded, 0);
+
+	return testFinish("shaping");
+}
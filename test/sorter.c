@@ -0,0 +1,105 @@
+/** @file sorter.c
+ * @brief Host unit test of the sorter's strokes and jam handling
+ *
+ * The paddle is a plant the test moves by hand: each cycle it follows the command at a fixed
+ * gain, unless the test has jammed it.
+ */
+
+#include "main.h"
+#include "test.h"
+
+// Encoder ticks the paddle moves per cycle per unit of motor command
+#define TICKS_PER_COMMAND 0.1
+
+Encoder sorter;
+
+static unsigned long now;
+static int count;
+static int command;
+static bool jammed;
+
+unsigned long millis()
+{
+	return now;
+}
+
+unsigned long micros()
+{
+	return now * 1000;
+}
+
+int encoderGet(Encoder enc)
+{
+	return count;
+}
+
+void motorsCommand(unsigned char port, int speed)
+{
+	if (port == SORTER)
+		command = speed;
+}
+
+void motorsStop(unsigned char port)
+{
+	motorsCommand(port, 0);
+}
+
+// Runs the sorter for some milliseconds of MECHANISM_PERIOD_MS cycles
+static void run(unsigned long ms)
+{
+	unsigned long end = now + ms;
+	SensorFrame sens;
+
+	while (now < end)
+	{
+		sens.sorterCount = count;
+		sorterUpdate(&sens);
+		if (!jammed)
+			count += (int)(command * TICKS_PER_COMMAND * MECHANISM_PERIOD_MS / 10);
+		now += MECHANISM_PERIOD_MS;
+	}
+}
+
+int main()
+{
+	const SorterStats *stats = sorterGetStats();
+	int stopped;
+
+	// Starts on the paddle position nearest the encoder, and sorts a friendly ball
+	now = 1000;
+	count = 40;
+	sorterInit();
+	sorterEnqueue(false, micros());
+	run(1500);
+	CHECK(sorterIdle());
+	CHECK_EQUAL(stats->sorted, 1);
+	CHECK_EQUAL(stats->timeouts, 0);
+	CHECK(abs(count - SORTER_STROKE) <= SORTER_TOLERANCE);
+
+	// A jam part way through a stroke times out: the ball is not counted and the paddle is
+	// left unpowered instead of pushing into the jam
+	sorterEnqueue(true, micros());
+	run(60);
+	CHECK(count > SORTER_STROKE / 2);
+	jammed = true;
+	run(2000);
+	CHECK(sorterIdle());
+	CHECK_EQUAL(stats->sorted, 1);
+	CHECK_EQUAL(stats->timeouts, 1);
+	CHECK_EQUAL(command, 0);
+
+	// Once cleared, the next stroke starts from the position nearest where the paddle
+	// stopped, not from the one it never reached
+	stopped = (count + SORTER_STROKE / 2) / SORTER_STROKE * SORTER_STROKE;
+	CHECK_EQUAL(stopped, SORTER_STROKE);
+	jammed = false;
+	run(100);
+	CHECK_EQUAL(command, 0);
+	sorterEnqueue(false, micros());
+	run(1500);
+	CHECK_EQUAL(stats->sorted, 2);
+	CHECK_EQUAL(stats->timeouts, 1);
+	CHECK(abs(count - (stopped + SORTER_STROKE)) <= SORTER_TOLERANCE);
+
+	return testFinish("sorter");
+}
@@ -0,0 +1,75 @@
+/** @file test.h
+ * @brief Checks for the host unit tests
+ *
+ * A unit test is built like the simulator: the robot module under test against API.h, with
+ * prosnames.h forced in. Instead of the simulated kernel, the test defines the few PROS
+ * functions the module calls as stubs it controls. API.h hides the C library's stdio, so
+ * results are printed through sim/host/host.h.
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <API.h>
+#include <stdarg.h>
+
+#include "host/host.h"
+
+/**
+ * Checks a condition, reporting the file and line if it does not hold.
+ */
+#define CHECK(condition) testCheck((condition), #condition, __FILE__, __LINE__)
+/**
+ * Checks that two integer expressions are equal, reporting both values if they are not.
+ */
+#define CHECK_EQUAL(actual, expected) testCheckEqual((long)(actual), (long)(expected), \
+	#actual, __FILE__, __LINE__)
+
+static unsigned int testChecks;
+static unsigned int testFailures;
+
+static void testReport(int stream, const char *format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	hostVprintf(stream, format, args);
+	va_end(args);
+}
+
+static inline void testCheck(bool ok, const char *text, const char *file, int line)
+{
+	testChecks++;
+	if (!ok)
+	{
+		testFailures++;
+		testReport(HOST_STDERR, "%s:%d: check failed: %s\n", file, line, text);
+	}
+}
+
+static inline void testCheckEqual(long actual, long expected, const char *text,
+	const char *file, int line)
+{
+	testChecks++;
+	if (actual != expected)
+	{
+		testFailures++;
+		testReport(HOST_STDERR, "%s:%d: %s is %ld, expected %ld\n", file, line, text, actual,
+			expected);
+	}
+}
+
+/**
+ * Prints the totals of a test.
+ *
+ * @param name the test name
+ * @return the process exit status: 0 if every check held
+ */
+static inline int testFinish(const char *name)
+{
+	testReport(testFailures ? HOST_STDERR : HOST_STDOUT, "%s: %u checks, %u failed\n", name,
+		testChecks, testFailures);
+	return testFailures ? 1 : 0;
+}
+
+#endif
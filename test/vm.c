@@ -0,0 +1,188 @@
+/** @file vm.c
+ * @brief Host unit test of the bytecode VM's program checks and threads
+ *
+ * Programs are loaded from an in-memory flash file. A move started with trajectoryStartMove()
+ * lasts as many ticks as its forward distance, counted down by the test after each tick.
+ */
+
+#include "main.h"
+#include "test.h"
+#include <string.h>
+
+static unsigned long now;
+static unsigned char file[6 + VM_PROGRAM_SIZE];
+static size_t fileLength;
+static size_t filePos;
+static PROS_FILE fileHandle;
+static int moveTicks;
+static int moves;
+static int commands[MOTOR_PORTS + 1];
+
+unsigned long millis()
+{
+	return now;
+}
+
+PROS_FILE* fopen(const char *name, const char *mode)
+{
+	filePos = 0;
+	return fileLength > 0 ? &fileHandle : NULL;
+}
+
+size_t fread(void *ptr, size_t size, size_t count, PROS_FILE *stream)
+{
+	size_t n = count;
+
+	if (n > (fileLength - filePos) / size)
+		n = (fileLength - filePos) / size;
+	memcpy(ptr, file + filePos, n * size);
+	filePos += n * size;
+	return n;
+}
+
+void fclose(PROS_FILE *stream)
+{
+}
+
+void trajectoryStartMove(int forward, int strafe, int turn, unsigned int maxVel,
+	unsigned int accel)
+{
+	moveTicks = forward;
+	moves++;
+}
+
+bool trajectoryActive()
+{
+	return moveTicks > 0;
+}
+
+void motorsCommand(unsigned char port, int speed)
+{
+	commands[port] = speed;
+}
+
+// Only vmTick() is run; vmRun() and its loop are never called
+bool trajectoryStep()
+{
+	return false;
+}
+
+void powerUpdate()
+{
+}
+
+void motorsFlush()
+{
+}
+
+void sensorsSample(SensorFrame *frame)
+{
+}
+
+void loopTimerInit(LoopTimer *timer, unsigned long periodMs)
+{
+}
+
+void loopTimerBegin(LoopTimer *timer)
+{
+}
+
+void loopTimerWait(LoopTimer *timer)
+{
+}
+
+// Writes a program to the flash file and loads it
+static bool load(const unsigned char *program, unsigned short length)
+{
+	memcpy(file, VM_MAGIC, 4);
+	file[4] = length & 0xFF;
+	file[5] = length >> 8;
+	memcpy(file + 6, program, length);
+	fileLength = 6 + length;
+	return vmLoad(VM_FILE);
+}
+
+// Runs one DRIVE_PERIOD_MS tick, moving the robot afterwards as trajectoryStep() would
+static bool tick()
+{
+	SensorFrame frame;
+	bool running;
+
+	memset(&frame, 0, sizeof(frame));
+	running = vmTick(&frame);
+	if (moveTicks > 0)
+		moveTicks--;
+	now += DRIVE_PERIOD_MS;
+	return running;
+}
+
+int main()
+{
+	static unsigned char full[VM_PROGRAM_SIZE];
+	// A forked thread that reaches a JOIN, whether its own or one the first thread also runs
+	static const unsigned char forkJoins[] = {
+		VM_PARALLEL, 4, 0, VM_END, VM_JOIN, VM_END
+	};
+	static const unsigned char forkIntoJoin[] = {
+		VM_PARALLEL, 3, 0, VM_JOIN, VM_END
+	};
+	static const unsigned char firstJoins[] = {
+		VM_PARALLEL, 5, 0, VM_JOIN, VM_END, VM_MOTOR, PICKUP, 127, VM_END
+	};
+	// The first thread starts a move in the tick the forked thread's move finishes
+	static const unsigned char handOver[] = {
+		VM_PARALLEL, 11, 0,
+		VM_WAIT, 20, 0,
+		VM_DRIVE, 5, 0,
+		VM_JOIN,
+		VM_END,
+		VM_DRIVE, 10, 0,
+		VM_MOTOR, PICKUP, 127,
+		VM_END
+	};
+	const VmStats *stats = vmGetStats();
+	int i;
+
+	// A program filling the whole buffer, ending on a one-byte instruction in its last byte
+	for (i = 0; i + 3 < VM_PROGRAM_SIZE; i += 3)
+	{
+		full[i] = VM_MOTOR;
+		full[i + 1] = PICKUP;
+		full[i + 2] = 0;
+	}
+	full[VM_PROGRAM_SIZE - 1] = VM_END;
+	CHECK(load(full, VM_PROGRAM_SIZE));
+
+	// Only the first thread may join
+	CHECK(!load(forkJoins, sizeof(forkJoins)));
+	CHECK(!vmLoaded());
+	CHECK(!load(forkIntoJoin, sizeof(forkIntoJoin)));
+	CHECK(load(firstJoins, sizeof(firstJoins)));
+	vmStart();
+	for (i = 0; i < 3 && tick(); i++);
+	CHECK_EQUAL(i, 1);
+	CHECK_EQUAL(commands[PICKUP], 127);
+
+	// Each motion instruction waits for its own move, not for one another thread starts
+	commands[PICKUP] = 0;
+	CHECK(load(handOver, sizeof(handOver)));
+	vmStart();
+	now = 0;
+	for (i = 0; i < 10; i++)
+		CHECK(tick());
+	CHECK_EQUAL(moves, 1);
+	CHECK_EQUAL(commands[PICKUP], 0);
+	// In tick 10 the forked thread's move is done and the first thread starts its own
+	CHECK(tick());
+	CHECK_EQUAL(moves, 2);
+	CHECK_EQUAL(commands[PICKUP], 127);
+	CHECK_EQUAL(stats->executed[VM_DRIVE], 1);
+	for (i = 0; i < 4; i++)
+		CHECK(tick());
+	CHECK_EQUAL(stats->executed[VM_DRIVE], 1);
+	CHECK(!tick());
+	CHECK_EQUAL(stats->executed[VM_DRIVE], 2);
+	CHECK_EQUAL(stats->executed[VM_JOIN], 1);
+
+	return testFinish("vm");
+}
@@ -0,0 +1,76 @@
+/** @file bench.h
+ * @brief Timing for the host benchmarks
+ *
+ * A benchmark tools/bench<module>.c is built like a host unit test: src/<module>.c against
+ * API.h with prosnames.h forced in, and stubs for the PROS functions it calls. It times the
+ * module against the code it replaced, copied into the benchmark, and prints host cycles per
+ * call of each. The host is not the Cortex, so the numbers compare the two versions with each
+ * other rather than predict their cost on the robot.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <API.h>
+#include <stdarg.h>
+
+#include "host/host.h"
+
+/**
+ * Times each pass this many times and keeps the fastest, which is the one least disturbed by
+ * interrupts and cache misses on the host.
+ */
+#define BENCH_RUNS 200
+
+/**
+ * Keeps the compiler from optimizing away a result the benchmark does not otherwise use.
+ */
+#define BENCH_KEEP __attribute__((noinline, noclone))
+
+static void benchPrintf(const char *format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	hostVprintf(HOST_STDOUT, format, args);
+	va_end(args);
+}
+
+/**
+ * Times a pass of calls.
+ *
+ * @param pass a function that makes the calls being timed
+ * @param calls the number of calls one pass makes
+ * @return the host cycles per call of the fastest pass
+ */
+static inline double benchCyclesPerCall(void (*pass)(), unsigned long calls)
+{
+	unsigned long long best = ~0ULL;
+	int i;
+
+	for (i = 0; i < BENCH_RUNS; i++)
+	{
+		unsigned long long start = hostCycles();
+		unsigned long long elapsed;
+
+		pass();
+		elapsed = hostCycles() - start;
+		if (elapsed < best)
+			best = elapsed;
+	}
+	return (double)best / calls;
+}
+
+/**
+ * Times a pass of calls and prints its host cycles per call.
+ *
+ * @param name the name of the code being timed
+ * @param pass a function that makes the calls being timed
+ * @param calls the number of calls one pass makes
+ */
+static inline void benchReport(const char *name, void (*pass)(), unsigned long calls)
+{
+	benchPrintf("%-24s %8.1f cycles per call\n", name, benchCyclesPerCall(pass, calls));
+}
+
+#endif
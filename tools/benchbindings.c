@@ -0,0 +1,180 @@
+/** @file benchbindings.c
+ * @brief Host benchmark of the binding table against the if/else chain it replaced
+ *
+ * Times bindingsUpdate() on the driver's table against the mechanism task's old chain of
+ * buttonHeld() and buttonPressed() checks, for one mechanism cycle each. The chain commanded
+ * every motor every cycle, and the table posts an event only on a button edge, so both are
+ * timed on cycles with no edge, which is most of them, and on cycles with one. The calls they
+ * end in (motor commands for the chain, fsmPost() for the table) are empty stubs, so only the
+ * resolution of the buttons is timed.
+ *
+ * Usage: make bench, or bin/host/benchbindings
+ */
+
+#include "main.h"
+#include "bench.h"
+
+// Mechanism cycles per pass, each with its own button state
+#define CYCLES 1024
+
+// defaultBindings from opcontrol.c
+static const Binding bindings[] = {
+	BIND(7, JOY_RIGHT, BIND_PRESS, MECH_PICKUP, PICKUP_TOGGLE),
+	BIND(7, JOY_LEFT, BIND_PRESS, MECH_PICKUP, PICKUP_HOLD),
+	BIND(7, JOY_LEFT, BIND_RELEASE, MECH_PICKUP, PICKUP_RELEASE),
+	BIND(5, JOY_DOWN, BIND_PRESS, MECH_SHOOTER, SHOOTER_START),
+	BIND(5, JOY_UP, BIND_PRESS, MECH_SHOOTER, SHOOTER_STOP),
+	BIND(6, JOY_UP, BIND_PRESS, MECH_RAMP, RAMP_UP),
+	BIND(6, JOY_UP, BIND_RELEASE, MECH_RAMP, RAMP_UP_RELEASE),
+	BIND(6, JOY_DOWN, BIND_PRESS, MECH_RAMP, RAMP_DOWN),
+	BIND(6, JOY_DOWN, BIND_RELEASE, MECH_RAMP, RAMP_DOWN_RELEASE),
+	BIND(8, JOY_UP, BIND_PRESS, MECH_LIFTER, LIFTER_RAISE),
+	BIND(8, JOY_UP, BIND_RELEASE, MECH_LIFTER, LIFTER_RAISE_RELEASE),
+	BIND(8, JOY_DOWN, BIND_PRESS, MECH_LIFTER, LIFTER_LOWER),
+	BIND(8, JOY_DOWN, BIND_RELEASE, MECH_LIFTER, LIFTER_LOWER_RELEASE),
+	BIND(8, JOY_LEFT, BIND_PRESS, MECH_SORTER, SORTER_FRIENDLY),
+	BIND(8, JOY_RIGHT, BIND_PRESS, MECH_SORTER, SORTER_ENEMY),
+	BIND(7, JOY_UP, BIND_PRESS, MECH_MIXER, MIXER_REVERSE),
+	BIND(7, JOY_UP, BIND_RELEASE, MECH_MIXER, MIXER_FORWARD),
+};
+static const BindingTable table = BINDING_TABLE(bindings);
+
+// Button states of the cycles without an edge and of the cycles with one
+static Buttons steady[CYCLES];
+static Buttons edges[CYCLES];
+static volatile unsigned long outputs;
+
+unsigned long micros()
+{
+	return 0;
+}
+
+bool fsmPost(unsigned char id, unsigned char event, long arg)
+{
+	outputs++;
+	return true;
+}
+
+// The calls the chain ends in, which the table leaves to the mechanism state machines
+BENCH_KEEP void motorsCommand(unsigned char port, int speed)
+{
+	outputs++;
+}
+
+BENCH_KEEP void motorsStop(unsigned char port)
+{
+	outputs++;
+}
+
+BENCH_KEEP void lifterDrive(int power)
+{
+	outputs++;
+}
+
+BENCH_KEEP bool sorterEnqueue(bool enemy, unsigned long time)
+{
+	outputs++;
+	return true;
+}
+
+// The button part of the mechanism task before the binding table
+static BENCH_KEEP void chainUpdate(const Buttons *btn)
+{
+	if (buttonToggled(btn, 7, JOY_RIGHT) || buttonHeld(btn, 7, JOY_LEFT))
+		motorsCommand(PICKUP, 127);
+	else
+		motorsStop(PICKUP);
+
+	if (buttonHeld(btn, 5, JOY_DOWN))
+		motorsCommand(SHOOTER, 80);
+	else if (buttonHeld(btn, 5, JOY_UP))
+		motorsStop(SHOOTER);
+
+	if (buttonHeld(btn, 6, JOY_UP))
+		motorsCommand(RAMP, 65);
+	else if (buttonHeld(btn, 6, JOY_DOWN))
+		motorsCommand(RAMP, -65);
+	else
+		motorsStop(RAMP);
+
+	if (buttonHeld(btn, 8, JOY_UP))
+		lifterDrive(127);
+	else if (buttonHeld(btn, 8, JOY_DOWN))
+		lifterDrive(-127);
+	else
+		lifterDrive(0);
+
+	if (buttonPressed(btn, 8, JOY_LEFT))
+		sorterEnqueue(false, 0);
+	if (buttonPressed(btn, 8, JOY_RIGHT))
+		sorterEnqueue(true, 0);
+
+	if (buttonHeld(btn, 7, JOY_UP))
+		motorsCommand(MIXER, -30);
+	else
+		motorsCommand(MIXER, 30);
+}
+
+static void passTableSteady()
+{
+	int i;
+
+	for (i = 0; i < CYCLES; i++)
+		bindingsUpdate(&steady[i]);
+}
+
+static void passChainSteady()
+{
+	int i;
+
+	for (i = 0; i < CYCLES; i++)
+		chainUpdate(&steady[i]);
+}
+
+static void passTableEdges()
+{
+	int i;
+
+	for (i = 0; i < CYCLES; i++)
+		bindingsUpdate(&edges[i]);
+}
+
+static void passChainEdges()
+{
+	int i;
+
+	for (i = 0; i < CYCLES; i++)
+		chainUpdate(&edges[i]);
+}
+
+int main()
+{
+	unsigned short held = 0;
+	unsigned short toggled = 0;
+	unsigned int random = 1;
+	int i;
+
+	// Buttons held at random, changing one bound button on every cycle of the edge pass
+	for (i = 0; i < CYCLES; i++)
+	{
+		unsigned short button;
+
+		random = random * 1103515245 + 12345;
+		button = bindings[(random >> 16) % (sizeof(bindings) / sizeof(bindings[0]))].button;
+		steady[i].held = held;
+		steady[i].toggled = toggled;
+		edges[i].pressed = button & ~held;
+		edges[i].released = button & held;
+		held ^= button;
+		toggled ^= edges[i].pressed;
+		edges[i].held = held;
+		edges[i].toggled = toggled;
+	}
+
+	bindingsSelect(&table);
+	benchReport("table, no edge", passTableSteady, CYCLES);
+	benchReport("if/else chain, no edge", passChainSteady, CYCLES);
+	benchReport("table, one edge", passTableEdges, CYCLES);
+	benchReport("if/else chain, one edge", passChainEdges, CYCLES);
+	return 0;
+}
@@ -0,0 +1,103 @@
+/** @file benchcoroutine.c
+ * @brief Host benchmark of the coroutine scheduler's cost per resume
+ *
+ * Runs coroutinesRun() on coroutines whose bodies do nothing but wait for the last cycle, so
+ * almost all the time measured is the scheduler's: the loop over the coroutines, the call
+ * through resume and the jump back to the wait. The sensor sampling, power manager, motor
+ * flush and loop timer it calls every cycle are empty stubs. Runs with two different numbers
+ * of coroutines separate the cost of each resume from the fixed cost of each cycle.
+ *
+ * Usage: make bench, or bin/host/benchcoroutine
+ */
+
+#include "main.h"
+#include "bench.h"
+
+// Scheduler cycles one run lasts
+#define CYCLES 100
+// Numbers of coroutines run
+#define FEW 1
+#define MANY 16
+
+static Coroutine coroutines[MANY];
+static unsigned long cycle;
+static volatile long checksum;
+
+// Each cycle of coroutinesRun() starts with loopTimerBegin(), which counts the cycles
+void loopTimerBegin(LoopTimer *timer)
+{
+	cycle++;
+}
+
+void loopTimerInit(LoopTimer *timer, unsigned long periodMs)
+{
+}
+
+void loopTimerWait(LoopTimer *timer)
+{
+}
+
+void sensorsSample(SensorFrame *frame)
+{
+}
+
+void powerUpdate()
+{
+}
+
+void motorsFlush()
+{
+}
+
+unsigned long millis()
+{
+	return 0;
+}
+
+// A coroutine that waits until the last cycle
+static unsigned char emptyAction(Coroutine *co, const SensorFrame *sens)
+{
+	CO_BEGIN(co);
+	CO_WAIT_UNTIL(co, cycle >= CYCLES);
+	CO_END(co);
+}
+
+static void run(unsigned char count)
+{
+	cycle = 0;
+	coroutinesRun(coroutines, count);
+	checksum += coroutinesGetStats()->resumes;
+}
+
+static void passFew()
+{
+	run(FEW);
+}
+
+static void passMany()
+{
+	run(MANY);
+}
+
+int main()
+{
+	double few, many, perResume;
+	int i;
+
+	for (i = 0; i < MANY; i++)
+		coroutines[i].resume = emptyAction;
+	// Cycles per scheduler cycle, for each number of coroutines
+	few = benchCyclesPerCall(passFew, CYCLES);
+	many = benchCyclesPerCall(passMany, CYCLES);
+	if (coroutinesGetStats()->resumes != MANY * CYCLES)
+	{
+		benchPrintf("benchcoroutine: %lu resumes, expected %d\n", coroutinesGetStats()->resumes,
+			MANY * CYCLES);
+		return 1;
+	}
+	perResume = (many - few) / (MANY - FEW);
+	benchPrintf("%-24s %8.1f cycles per resume\n", "resume", perResume);
+	benchPrintf("%-24s %8.1f cycles per scheduler cycle\n", "cycle without resumes",
+		few - FEW * perResume);
+	return 0;
+}
@@ -0,0 +1,113 @@
+/** @file benchdrive.c
+ * @brief Host benchmark of the mecanum mixer against the moveRobot() it replaced
+ *
+ * Sweeps forward, turn and strafe over the stick range and times driveMix() against the wheel
+ * sums of the old moveRobot(), which left each wheel for motorSet() to clip on its own. Both
+ * go through motorSet() afterwards, so only the mixing is timed.
+ *
+ * Usage: make bench, or bin/host/benchdrive
+ */
+
+#include "main.h"
+#include "bench.h"
+
+// Stick values swept on each axis, from -127 to 127
+#define STICK_STEP 17
+#define STICK_VALUES (2 * 127 / STICK_STEP + 1)
+#define COMMANDS (STICK_VALUES * STICK_VALUES * STICK_VALUES)
+
+static int commands[COMMANDS][3];
+static volatile long checksum;
+
+// Only driveMix() is linked from drive.c; the rest of the module is never called
+void motorsSetSlew(unsigned char port, unsigned int accel, unsigned int decel)
+{
+}
+
+void motorsCommand(unsigned char port, int speed)
+{
+}
+
+void motorsStop(unsigned char port)
+{
+}
+
+unsigned int imeInitializeAll()
+{
+	return 0;
+}
+
+bool imeGet(unsigned char address, int *value)
+{
+	return false;
+}
+
+// The mixing of moveRobot() before the drive module
+static BENCH_KEEP void moveRobotMix(int forward, int turn, int strafe, int wheels[DRIVE_WHEELS])
+{
+	wheels[DRIVE_FRONT_LEFT] = 0 - turn - forward + strafe;
+	wheels[DRIVE_FRONT_RIGHT] = 0 - turn + forward + strafe;
+	wheels[DRIVE_BACK_LEFT] = 0 - turn - forward - strafe;
+	wheels[DRIVE_BACK_RIGHT] = 0 - turn + forward - strafe;
+}
+
+// An empty call, for the cost of the loop and the call itself
+static BENCH_KEEP void emptyMix(int forward, int turn, int strafe, int wheels[DRIVE_WHEELS])
+{
+	__asm__ volatile ("");
+}
+
+static void sweep(void (*mix)(int, int, int, int *))
+{
+	int wheels[DRIVE_WHEELS];
+	long sum = 0;
+	int i;
+
+	for (i = 0; i < COMMANDS; i++)
+	{
+		mix(commands[i][0], commands[i][1], commands[i][2], wheels);
+		sum += wheels[DRIVE_FRONT_LEFT] + wheels[DRIVE_BACK_RIGHT];
+	}
+	checksum += sum;
+}
+
+static void passEmpty()
+{
+	sweep(emptyMix);
+}
+
+static void passMoveRobot()
+{
+	sweep(moveRobotMix);
+}
+
+static void passDriveMix()
+{
+	sweep(driveMix);
+}
+
+int main()
+{
+	int saturated = 0;
+	int i = 0;
+	int forward, turn, strafe;
+
+	for (forward = -127; forward <= 127; forward += STICK_STEP)
+		for (turn = -127; turn <= 127; turn += STICK_STEP)
+			for (strafe = -127; strafe <= 127; strafe += STICK_STEP)
+			{
+				commands[i][0] = forward;
+				commands[i][1] = turn;
+				commands[i][2] = strafe;
+				if (abs(forward) + abs(turn) + abs(strafe) > DRIVE_MAX_POWER)
+					saturated++;
+				i++;
+			}
+
+	benchPrintf("%d commands, %d%% of them saturating a wheel\n", COMMANDS,
+		saturated * 100 / COMMANDS);
+	benchReport("empty call", passEmpty, COMMANDS);
+	benchReport("moveRobot() mixing", passMoveRobot, COMMANDS);
+	benchReport("driveMix()", passDriveMix, COMMANDS);
+	return 0;
+}
@@ -0,0 +1,102 @@
+/** @file benchshaping.c
+ * @brief Host benchmark of the stick shaping tables against the per-axis deadzone they replaced
+ *
+ * Sweeps both sticks over their range and times shapingApply(), with the deadzone and curves
+ * operatorControl() sets, against the old drive loop's test of abs() of each axis against
+ * DEADZONE, which passed the raw axes on when any of them was outside it. Both fill the same
+ * four axes, so only the shaping is timed.
+ *
+ * Usage: make bench, or bin/host/benchshaping
+ */
+
+#include "main.h"
+#include "bench.h"
+#include <stdlib.h>
+
+// The deadzone set by operatorControl()
+#define DEADZONE 20
+// Stick values swept on each axis, from -127 to 127
+#define STICK_STEP 17
+#define STICK_VALUES (2 * 127 / STICK_STEP + 1)
+#define FRAMES (STICK_VALUES * STICK_VALUES * STICK_VALUES * STICK_VALUES)
+
+static InputFrame frames[FRAMES];
+static volatile long checksum;
+
+// The deadzone of the drive loop before the shaping module
+static BENCH_KEEP void deadzoneShape(const InputFrame *frame, int axes[INPUT_AXES])
+{
+	unsigned char i;
+
+	if (abs(inputAnalog(frame, 3)) > DEADZONE || abs(inputAnalog(frame, 4)) > DEADZONE ||
+		abs(inputAnalog(frame, 1)) > DEADZONE)
+		for (i = 0; i < INPUT_AXES; i++)
+			axes[i] = frame->axis[i];
+	else
+		for (i = 0; i < INPUT_AXES; i++)
+			axes[i] = 0;
+}
+
+// An empty call, for the cost of the loop and the call itself
+static BENCH_KEEP void emptyShape(const InputFrame *frame, int axes[INPUT_AXES])
+{
+	__asm__ volatile ("");
+}
+
+static void sweep(void (*shape)(const InputFrame *, int *))
+{
+	int axes[INPUT_AXES] = { 0 };
+	long sum = 0;
+	int i;
+
+	for (i = 0; i < FRAMES; i++)
+	{
+		shape(&frames[i], axes);
+		sum += axes[0] + axes[2] + axes[3];
+	}
+	checksum += sum;
+}
+
+static void passEmpty()
+{
+	sweep(emptyShape);
+}
+
+static void passDeadzone()
+{
+	sweep(deadzoneShape);
+}
+
+static void passShaping()
+{
+	sweep(shapingApply);
+}
+
+int main()
+{
+	int i = 0;
+	int a, b, c, d;
+
+	for (a = -127; a <= 127; a += STICK_STEP)
+		for (b = -127; b <= 127; b += STICK_STEP)
+			for (c = -127; c <= 127; c += STICK_STEP)
+				for (d = -127; d <= 127; d += STICK_STEP)
+				{
+					frames[i].axis[0] = (signed char)a;
+					frames[i].axis[1] = (signed char)b;
+					frames[i].axis[2] = (signed char)c;
+					frames[i].axis[3] = (signed char)d;
+					i++;
+				}
+	shapingInit(DEADZONE);
+	shapingSetDeadzoneShape(SHAPE_STICK_RIGHT, SHAPE_AXIAL);
+	shapingSetCurve(AXIS_LEFT_Y, SHAPE_EXPO);
+	shapingSetCurve(AXIS_LEFT_X, SHAPE_EXPO);
+	shapingSetCurve(AXIS_RIGHT_X, SHAPE_EXPO);
+
+	benchPrintf("%d frames\n", FRAMES);
+	benchReport("empty call", passEmpty, FRAMES);
+	benchReport("per-axis deadzone", passDeadzone, FRAMES);
+	benchReport("shapingApply()", passShaping, FRAMES);
+	return 0;
+}
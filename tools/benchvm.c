@@ -0,0 +1,209 @@
+/** @file benchvm.c
+ * @brief Host benchmark of the bytecode VM's cost per instruction, by opcode
+ *
+ * For each opcode, runs a tick of a program of VM_TICK_BUDGET - 1 copies of one instruction
+ * and an END, and subtracts the cost of a tick of the END alone. The instructions are chosen so
+ * none of them waits: moves finish at once, WAIT is for 0 ms and the sensor waits already hold.
+ * PARALLEL can only fork VM_THREADS - 1 threads, so it is timed with that many, each counted
+ * with the END its thread runs.
+ *
+ * Usage: make bench, or bin/host/benchvm
+ */
+
+#include "main.h"
+#include "bench.h"
+#include <string.h>
+
+// Ticks one pass runs
+#define TICKS 1000
+#define COPIES (VM_TICK_BUDGET - 1)
+
+typedef struct {
+	const char *name;
+	unsigned char length;
+	unsigned char code[6];
+} BenchInstruction;
+
+// One instruction of each opcode, with operands that do not wait
+static const BenchInstruction instructions[] = {
+	{ "DRIVE", 3, { VM_DRIVE, 100, 0 } },
+	{ "STRAFE", 3, { VM_STRAFE, 100, 0 } },
+	{ "TURN", 3, { VM_TURN, 100, 0 } },
+	{ "LIMITS", 5, { VM_LIMITS, 0x20, 0x03, 0x40, 0x06 } },
+	{ "MOTOR", 3, { VM_MOTOR, PICKUP, 127 } },
+	{ "WAIT", 3, { VM_WAIT, 0, 0 } },
+	// Pin low, and channel 1 at mid scale, above 0 and below 4095
+	{ "WAITPIN", 5, { VM_WAITPIN, ARDUINO_SENS_OUT, 0, 0xA0, 0x0F } },
+	{ "WAITABOVE", 6, { VM_WAITABOVE, 1, 0, 0, 0xA0, 0x0F } },
+	{ "WAITBELOW", 6, { VM_WAITBELOW, 1, 0xFF, 0x0F, 0xA0, 0x0F } },
+	// With no other thread, a JOIN never waits
+	{ "JOIN", 1, { VM_JOIN } },
+};
+
+static unsigned char file[6 + VM_PROGRAM_SIZE];
+static size_t fileLength;
+static size_t filePos;
+static PROS_FILE fileHandle;
+static SensorFrame frame;
+static volatile long checksum;
+
+unsigned long millis()
+{
+	return 0;
+}
+
+PROS_FILE* fopen(const char *name, const char *mode)
+{
+	filePos = 0;
+	return &fileHandle;
+}
+
+size_t fread(void *ptr, size_t size, size_t count, PROS_FILE *stream)
+{
+	size_t n = count;
+
+	if (n > (fileLength - filePos) / size)
+		n = (fileLength - filePos) / size;
+	memcpy(ptr, file + filePos, n * size);
+	filePos += n * size;
+	return n;
+}
+
+void fclose(PROS_FILE *stream)
+{
+}
+
+// Moves finish as soon as they start, so only the dispatch and the call are timed
+void trajectoryStartMove(int forward, int strafe, int turn, unsigned int maxVel,
+	unsigned int accel)
+{
+	checksum += forward + strafe + turn;
+}
+
+bool trajectoryActive()
+{
+	return false;
+}
+
+void motorsCommand(unsigned char port, int speed)
+{
+	checksum += speed;
+}
+
+// Only vmTick() is timed; vmRun() and its loop are never called
+bool trajectoryStep()
+{
+	return false;
+}
+
+void powerUpdate()
+{
+}
+
+void motorsFlush()
+{
+}
+
+void sensorsSample(SensorFrame *frame)
+{
+}
+
+void loopTimerInit(LoopTimer *timer, unsigned long periodMs)
+{
+}
+
+void loopTimerBegin(LoopTimer *timer)
+{
+}
+
+void loopTimerWait(LoopTimer *timer)
+{
+}
+
+// Loads copies of an instruction followed by an END
+static void load(const unsigned char *code, unsigned char length, int copies)
+{
+	unsigned short size = 0;
+	int i;
+
+	for (i = 0; i < copies; i++, size += length)
+		memcpy(file + 6 + size, code, length);
+	file[6 + size++] = VM_END;
+	memcpy(file, VM_MAGIC, 4);
+	file[4] = size & 0xFF;
+	file[5] = size >> 8;
+	fileLength = 6 + size;
+	if (!vmLoad(VM_FILE))
+	{
+		benchPrintf("benchvm: program rejected\n");
+		exit(1);
+	}
+}
+
+// Loads forks of threads that only END, followed by an END
+static void loadForks(int forks)
+{
+	unsigned char code[3 * VM_THREADS + VM_THREADS];
+	unsigned short size = 0;
+	int i;
+
+	for (i = 0; i < forks; i++)
+	{
+		code[size++] = VM_PARALLEL;
+		code[size++] = 3 * forks + 1 + i;
+		code[size++] = 0;
+	}
+	for (i = 0; i <= forks; i++)
+		code[size++] = VM_END;
+	load(code, size - 1, 1);
+}
+
+static void passTick()
+{
+	int i;
+
+	for (i = 0; i < TICKS; i++)
+	{
+		vmStart();
+		vmTick(&frame);
+	}
+	checksum += vmGetStats()->instructions;
+}
+
+// Times a tick of the loaded program, checking that it ran every instruction without waiting
+static double timeTick(unsigned long instructions)
+{
+	double cycles = benchCyclesPerCall(passTick, TICKS);
+
+	if (vmGetStats()->instructions != instructions)
+	{
+		benchPrintf("benchvm: %lu of %lu instructions ran in a tick\n",
+			vmGetStats()->instructions, instructions);
+		exit(1);
+	}
+	return cycles;
+}
+
+int main()
+{
+	double end;
+	size_t i;
+
+	memset(&frame, 0, sizeof(frame));
+	frame.analog[0] = 2048;
+	load(NULL, 0, 0);
+	end = timeTick(1);
+	benchPrintf("%-24s %8.1f cycles per tick\n", "END", end);
+	for (i = 0; i < sizeof(instructions) / sizeof(instructions[0]); i++)
+	{
+		const BenchInstruction *in = &instructions[i];
+
+		load(in->code, in->length, COPIES);
+		benchPrintf("%-24s %8.1f cycles per instruction\n", in->name,
+			(timeTick(COPIES + 1) - end) / COPIES);
+	}
+	loadForks(VM_THREADS - 1);
+	benchPrintf("%-24s %8.1f cycles per instruction\n", "PARALLEL (+ END)",
+		(timeTick(2 * (VM_THREADS - 1) + 1) - end) / (VM_THREADS - 1));
+	return 0;
+}
@@ -0,0 +1,122 @@
+/** @file mklut.c
+ * @brief Host-side generator for the motor linearization table
+ *
+ * Reads measured motor speed against motorSet() command as CSV lines of "command,speed" (any
+ * speed unit; lines that do not start with a number are skipped) and writes the C source of
+ * motorLinearTable (see motors.h) to standard output. Entry k of the table is the command
+ * that makes the motor turn at k/127 of its top speed, found by linear interpolation between
+ * the measured points. Negative commands are folded onto positive ones, so a reverse sweep can
+ * be measured in the same file.
+ *
+ * Usage: mklut motor393.csv > motorlut.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Measured speed at each command magnitude, and how many samples were averaged into it
+static double speedSum[128];
+static int samples[128];
+
+int main(int argc, char **argv)
+{
+	FILE *in = stdin;
+	char line[256];
+	double speed[128];
+	double top = 0.0;
+	int points = 0;
+	int command;
+	int k;
+
+	if (argc > 1)
+	{
+		in = fopen(argv[1], "r");
+		if (in == NULL)
+		{
+			perror(argv[1]);
+			return 1;
+		}
+	}
+	while (fgets(line, sizeof(line), in) != NULL)
+	{
+		double s;
+
+		if (sscanf(line, "%d , %lf", &command, &s) != 2)
+			continue;
+		command = abs(command);
+		if (command > 127)
+			continue;
+		speedSum[command] += s < 0.0 ? -s : s;
+		samples[command]++;
+	}
+	if (in != stdin)
+		fclose(in);
+	if (samples[0] == 0)
+	{
+		// The motor is at rest with no command whether or not that was measured
+		samples[0] = 1;
+		speedSum[0] = 0.0;
+	}
+	if (samples[127] == 0)
+	{
+		fprintf(stderr, "mklut: no measurement at command 127\n");
+		return 1;
+	}
+
+	// Fill the gaps between measurements by interpolation, and keep the curve non-decreasing
+	// so measurement noise cannot make the inverse jump backwards
+	for (command = 0; command < 128; command++)
+	{
+		if (samples[command] > 0)
+		{
+			int prev;
+
+			speed[command] = speedSum[command] / samples[command];
+			for (prev = command - 1; prev >= 0 && samples[prev] == 0; prev--);
+			for (k = prev + 1; k < command; k++)
+				speed[k] = speed[prev] + (speed[command] - speed[prev]) * (k - prev) /
+					(command - prev);
+			points++;
+		}
+		if (command > 0 && speed[command] < speed[command - 1])
+			speed[command] = speed[command - 1];
+	}
+	top = speed[127];
+	if (top <= 0.0)
+	{
+		fprintf(stderr, "mklut: motor does not move at command 127\n");
+		return 1;
+	}
+
+	printf("/** @file motorlut.c\n");
+	printf(" * @brief Motor linearization table\n");
+	printf(" *\n");
+	printf(" * Generated by tools/mklut.c from %d measured points; do not edit. Run make lut\n",
+		points);
+	printf(" * after changing the measurements.\n");
+	printf(" */\n\n");
+	printf("#include \"main.h\"\n\n");
+	printf("const unsigned char motorLinearTable[128] = {");
+	command = 0;
+	for (k = 0; k < 128; k++)
+	{
+		double want = top * k / 127.0;
+		int out;
+
+		// First command whose speed reaches the wanted speed, then back up along the segment
+		while (command < 127 && speed[command] < want)
+			command++;
+		if (k == 0)
+			out = 0;
+		else if (command == 0 || speed[command] == speed[command - 1])
+			out = command;
+		else
+			out = (int)(command - 1 + (want - speed[command - 1]) /
+				(speed[command] - speed[command - 1]) + 0.5);
+		if (k > 0 && out < 1)
+			out = 1;
+		printf("%s%3d%s", k % 16 == 0 ? "\n\t" : " ", out, k < 127 ? "," : "");
+	}
+	printf("\n};\n");
+	return 0;
+}
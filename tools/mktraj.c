@@ -0,0 +1,251 @@
+/** @file mktraj.c
+ * @brief Host-side generator for the autonomous drive trajectories
+ *
+ * Reads a path description and writes the C source of the trajectory tables (see trajectory.h)
+ * to standard output, or with -h the header declaring them. Each path is a sequence of moves in
+ * the robot's frame; every move is a trapezoidal profile on the wheel that travels furthest,
+ * with the other wheels scaled to it, so all four start and stop together. The wheel travel of
+ * a move follows the same mecanum mix as driveMix().
+ *
+ *     path <name>                          start a trajectory named <name>
+ *     limits <ticks/s> <ticks/s^2>         wheel velocity and acceleration for later moves
+ *     move <forward in> <strafe in> <turn degrees>
+ *     pause <ms>                           hold still
+ *
+ * '#' starts a comment. Velocities are emitted with their rounding carried into the next
+ * point, so the sum of a table matches the planned travel to within one point.
+ *
+ * Usage: mktraj [-h] paths.txt > paths.c
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Must match TRAJECTORY_PERIOD_MS and the DRIVE_* wheel order in drive.h
+#define PERIOD_MS 10
+#define WHEELS 4
+// IME ticks per inch of travel for 4" wheels at 627.2 ticks per turn, and per degree of turn
+// for wheels 14.5" from the centre along each axis combined
+#define TICKS_PER_INCH (627.2 / (4.0 * M_PI))
+#define TICKS_PER_DEGREE (TICKS_PER_INCH * 14.5 * M_PI / 180.0)
+#define MAX_PATHS 32
+#define MAX_POINTS 6000
+
+typedef struct {
+	char name[64];
+	int length;
+	short (*points)[WHEELS];
+} Path;
+
+static Path paths[MAX_PATHS];
+static int pathCount;
+
+// Travel emitted so far on each wheel of the current path, in milliticks
+static long long emitted[WHEELS];
+
+static void emit(Path *path, const double target[WHEELS], int line)
+{
+	int i;
+
+	if (path->length >= MAX_POINTS)
+	{
+		fprintf(stderr, "mktraj: line %d: path %s is too long\n", line, path->name);
+		exit(1);
+	}
+	for (i = 0; i < WHEELS; i++)
+	{
+		// Velocity in ticks per second that brings the emitted travel closest to the target
+		long v = lround((target[i] * 1000.0 - emitted[i]) / PERIOD_MS);
+
+		if (v > 32767 || v < -32767)
+		{
+			fprintf(stderr, "mktraj: line %d: wheel velocity out of range\n", line);
+			exit(1);
+		}
+		path->points[path->length][i] = (short)v;
+		emitted[i] += v * PERIOD_MS;
+	}
+	path->length++;
+}
+
+static void move(Path *path, double forward, double strafe, double turn, double maxVel,
+	double accel, int line)
+{
+	double wheels[WHEELS];
+	double start[WHEELS];
+	double distance = 0.0;
+	double accelTime, cruiseTime, peak, total;
+	int i, k, steps;
+
+	forward *= TICKS_PER_INCH;
+	strafe *= TICKS_PER_INCH;
+	turn *= TICKS_PER_DEGREE;
+	wheels[0] = -turn - forward + strafe;
+	wheels[1] = -turn + forward + strafe;
+	wheels[2] = -turn - forward - strafe;
+	wheels[3] = -turn + forward - strafe;
+	for (i = 0; i < WHEELS; i++)
+	{
+		start[i] = emitted[i] / 1000.0;
+		if (fabs(wheels[i]) > distance)
+			distance = fabs(wheels[i]);
+	}
+	if (distance == 0.0)
+		return;
+
+	// Trapezoid on the furthest wheel, or a triangle if it cannot reach maxVel
+	peak = maxVel;
+	if (peak * peak / accel > distance)
+		peak = sqrt(distance * accel);
+	accelTime = peak / accel;
+	cruiseTime = (distance - peak * peak / accel) / peak;
+	total = 2.0 * accelTime + cruiseTime;
+	steps = (int)ceil(total * 1000.0 / PERIOD_MS);
+	for (k = 1; k <= steps; k++)
+	{
+		double t = k * PERIOD_MS / 1000.0;
+		double travel;
+		double target[WHEELS];
+
+		if (t >= total)
+			travel = distance;
+		else if (t < accelTime)
+			travel = accel * t * t / 2.0;
+		else if (t < accelTime + cruiseTime)
+			travel = peak * accelTime / 2.0 + peak * (t - accelTime);
+		else
+			travel = distance - accel * (total - t) * (total - t) / 2.0;
+		for (i = 0; i < WHEELS; i++)
+			target[i] = start[i] + wheels[i] * travel / distance;
+		emit(path, target, line);
+	}
+}
+
+static void writeSource(const char *input)
+{
+	int p, k;
+
+	printf("/** @file paths.c\n");
+	printf(" * @brief Autonomous drive trajectories\n");
+	printf(" *\n");
+	printf(" * Generated by tools/mktraj.c from %s; do not edit. Run make paths after\n", input);
+	printf(" * changing the paths.\n");
+	printf(" */\n\n");
+	printf("#include \"main.h\"\n");
+	printf("#include \"paths.h\"\n");
+	for (p = 0; p < pathCount; p++)
+	{
+		printf("\n// %d points, %.2f s\n", paths[p].length,
+			paths[p].length * PERIOD_MS / 1000.0);
+		printf("static const TrajectoryPoint %sPoints[] = {\n", paths[p].name);
+		for (k = 0; k < paths[p].length; k++)
+			printf("\t{ { %d, %d, %d, %d } },\n", paths[p].points[k][0],
+				paths[p].points[k][1], paths[p].points[k][2], paths[p].points[k][3]);
+		printf("};\n");
+		printf("const Trajectory %s = { %sPoints, %d };\n", paths[p].name, paths[p].name,
+			paths[p].length);
+	}
+}
+
+static void writeHeader(const char *input)
+{
+	int p;
+
+	printf("/** @file paths.h\n");
+	printf(" * @brief Autonomous drive trajectories\n");
+	printf(" *\n");
+	printf(" * Generated by tools/mktraj.c from %s; do not edit.\n", input);
+	printf(" */\n\n");
+	printf("#ifndef PATHS_H_\n");
+	printf("#define PATHS_H_\n\n");
+	printf("#include \"trajectory.h\"\n\n");
+	for (p = 0; p < pathCount; p++)
+		printf("extern const Trajectory %s;\n", paths[p].name);
+	printf("\n#endif\n");
+}
+
+int main(int argc, char **argv)
+{
+	const char *input;
+	FILE *in;
+	char text[256];
+	Path *path = NULL;
+	double maxVel = 800.0;
+	double accel = 1600.0;
+	int header = 0;
+	int line = 0;
+
+	if (argc > 1 && strcmp(argv[1], "-h") == 0)
+	{
+		header = 1;
+		argc--;
+		argv++;
+	}
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: mktraj [-h] paths.txt\n");
+		return 2;
+	}
+	input = argv[1];
+	// Name the input as the generated comments should, relative to the project root
+	if (strncmp(input, "./", 2) == 0)
+		input += 2;
+	in = fopen(argv[1], "r");
+	if (in == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+	while (fgets(text, sizeof(text), in) != NULL)
+	{
+		char word[64];
+		char *comment = strchr(text, '#');
+		double a, b, c;
+
+		line++;
+		if (comment != NULL)
+			*comment = '\0';
+		if (sscanf(text, "%63s", word) != 1)
+			continue;
+		if (strcmp(word, "path") == 0 && pathCount < MAX_PATHS &&
+			sscanf(text, "%*s %63s", paths[pathCount].name) == 1)
+		{
+			path = &paths[pathCount++];
+			path->points = malloc(sizeof(*path->points) * MAX_POINTS);
+			memset(emitted, 0, sizeof(emitted));
+		}
+		else if (strcmp(word, "limits") == 0 && sscanf(text, "%*s %lf %lf", &a, &b) == 2 &&
+			a > 0.0 && b > 0.0)
+		{
+			maxVel = a;
+			accel = b;
+		}
+		else if (strcmp(word, "move") == 0 && path != NULL &&
+			sscanf(text, "%*s %lf %lf %lf", &a, &b, &c) == 3)
+			move(path, a, b, c, maxVel, accel, line);
+		else if (strcmp(word, "pause") == 0 && path != NULL && sscanf(text, "%*s %lf", &a) == 1)
+		{
+			double target[WHEELS];
+			int i, k;
+
+			for (i = 0; i < WHEELS; i++)
+				target[i] = emitted[i] / 1000.0;
+			for (k = 0; k < (int)(a / PERIOD_MS); k++)
+				emit(path, target, line);
+		}
+		else
+		{
+			fprintf(stderr, "mktraj: %s:%d: cannot parse: %s", input, line, text);
+			return 1;
+		}
+	}
+	fclose(in);
+
+	if (header)
+		writeHeader(input);
+	else
+		writeSource(input);
+	return 0;
+}
@@ -0,0 +1,110 @@
+/** @file teldecode.c
+ * @brief Host-side decoder for the robot's telemetry stream
+ *
+ * Reads framed telemetry (see wire.h) from a capture file, a serial device or standard input
+ * and writes one CSV row per valid frame to standard output as it arrives. Frames that fail
+ * COBS decoding or the CRC are skipped and the decoder resynchronizes on the next delimiter.
+ * Gaps in the sequence numbers are counted as lost frames. A summary goes to standard error
+ * at end of input.
+ *
+ * Usage: teldecode [capture.bin | /dev/ttyACM0]
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "wire.h"
+
+static const char* typeName(uint8_t type)
+{
+	switch (type)
+	{
+	case TELEM_MOTOR:
+		return "motor";
+	case TELEM_ENCODER:
+		return "encoder";
+	case TELEM_SWITCH:
+		return "switch";
+	case TELEM_LOOP:
+		return "loop";
+	case TELEM_PROFILE:
+		return "profile";
+	case TELEM_LIFTER:
+		return "lifter";
+	case TELEM_POWER:
+		return "power";
+	case TELEM_TRAJECTORY:
+		return "trajectory";
+	case TELEM_RECORDER:
+		return "recorder";
+	default:
+		return "unknown";
+	}
+}
+
+int main(int argc, char **argv)
+{
+	FILE *in = stdin;
+	uint8_t chunk[4096];
+	uint8_t frame[WIRE_FRAME_MAX];
+	size_t frameLen = 0;
+	int overlong = 0;
+	int haveSeq = 0;
+	uint8_t lastSeq = 0;
+	unsigned long good = 0, bad = 0, lost = 0;
+	size_t n;
+
+	if (argc > 1)
+	{
+		in = fopen(argv[1], "rb");
+		if (in == NULL)
+		{
+			perror(argv[1]);
+			return 1;
+		}
+	}
+
+	printf("seq,time_ms,type,channel,value\n");
+	while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0)
+	{
+		size_t i;
+
+		for (i = 0; i < n; i++)
+		{
+			TelemetryRecord record;
+			uint8_t seq;
+
+			if (chunk[i] != 0)
+			{
+				// Keep consuming an overlong frame until its delimiter, then reject it whole
+				if (frameLen < sizeof(frame))
+					frame[frameLen++] = chunk[i];
+				else
+					overlong = 1;
+				continue;
+			}
+			if (frameLen == 0)
+				continue;
+			if (!overlong && wireDecodeFrame(frame, frameLen, &seq, &record))
+			{
+				if (haveSeq)
+					lost += (uint8_t)(seq - lastSeq - 1);
+				haveSeq = 1;
+				lastSeq = seq;
+				good++;
+				printf("%u,%lu,%s,%u,%ld\n", seq, (unsigned long)record.time,
+					typeName(record.type), record.channel, (long)record.value);
+			}
+			else
+				bad++;
+			frameLen = 0;
+			overlong = 0;
+		}
+		fflush(stdout);
+	}
+
+	fprintf(stderr, "%lu frames decoded, %lu corrupt, %lu lost\n", good, bad, lost);
+	if (in != stdin)
+		fclose(in);
+	return 0;
+}
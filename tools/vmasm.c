@@ -0,0 +1,273 @@
+/** @file vmasm.c
+ * @brief Host-side assembler for the autonomous bytecode VM
+ *
+ * Reads a routine and writes the program file loaded by vmLoad() (see vm.h) to standard output.
+ * Distances are in inches and turns in degrees, converted to IME ticks of wheel travel with the
+ * same constants as tools/mktraj.c. One instruction per line:
+ *
+ *     limits <ticks/s> <ticks/s^2>         wheel velocity and acceleration for later moves
+ *     drive <in>
+ *     strafe <in>
+ *     turn <degrees>                       positive turns the way a positive turn stick does
+ *     motor <port> <speed>                 port by number or main.h name, e.g. SHOOTER
+ *     wait <ms>
+ *     waitpin <pin> high|low <timeout ms>
+ *     waitabove <channel> <value> <timeout ms>
+ *     waitbelow <channel> <value> <timeout ms>
+ *     parallel <label>                     start a thread at a later label
+ *     join                                 wait for the threads started to end; not
+ *                                          allowed in a thread started by parallel
+ *     end                                  end this thread; the last line must be end
+ *
+ * A line may start with "<label>:". '#' starts a comment.
+ *
+ * Usage: vmasm routine.txt > routine
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Must match vm.h
+#define VM_PROGRAM_SIZE 1024
+#define VM_MAGIC "AVM1"
+enum {
+	VM_END, VM_DRIVE, VM_STRAFE, VM_TURN, VM_LIMITS, VM_MOTOR, VM_WAIT, VM_WAITPIN,
+	VM_WAITABOVE, VM_WAITBELOW, VM_PARALLEL, VM_JOIN
+};
+// Must match tools/mktraj.c
+#define TICKS_PER_INCH (627.2 / (4.0 * M_PI))
+#define TICKS_PER_DEGREE (TICKS_PER_INCH * 14.5 * M_PI / 180.0)
+#define MAX_LABELS 64
+
+typedef struct {
+	char name[64];
+	int address;
+} Label;
+
+// A parallel whose target is filled in once every label is known
+typedef struct {
+	Label *label;
+	// Address of the target operand
+	int address;
+	int line;
+} Fixup;
+
+// Mechanism motor ports; must match main.h. The drive ports belong to the trajectory.
+static const struct {
+	const char *name;
+	int port;
+} ports[] = {
+	{ "PICKUP", 1 }, { "LIFTER", 6 }, { "SHOOTER", 7 }, { "RAMP", 8 }, { "SORTER", 9 },
+	{ "MIXER", 10 }
+};
+
+static const char *input;
+static int line;
+static unsigned char program[VM_PROGRAM_SIZE];
+static int length;
+// Source line of the instruction at each address, 0 inside an instruction
+static int lines[VM_PROGRAM_SIZE];
+static Label labels[MAX_LABELS];
+static int labelCount;
+static Fixup fixups[MAX_LABELS];
+static int fixupCount;
+
+static void fail(const char *message)
+{
+	fprintf(stderr, "vmasm: %s:%d: %s\n", input, line, message);
+	exit(1);
+}
+
+static void emit(long value, int bytes, long min, long max)
+{
+	if (value < min || value > max)
+		fail("operand out of range");
+	if (length + bytes > VM_PROGRAM_SIZE)
+		fail("program too long");
+	program[length++] = (unsigned char)(value & 0xFF);
+	if (bytes == 2)
+		program[length++] = (unsigned char)((value >> 8) & 0xFF);
+}
+
+static Label* label(const char *name)
+{
+	int i;
+
+	for (i = 0; i < labelCount; i++)
+		if (strcmp(labels[i].name, name) == 0)
+			return &labels[i];
+	if (labelCount >= MAX_LABELS)
+		fail("too many labels");
+	strcpy(labels[labelCount].name, name);
+	labels[labelCount].address = -1;
+	return &labels[labelCount++];
+}
+
+static long port(const char *name)
+{
+	size_t i;
+	char *end;
+	long number = strtol(name, &end, 10);
+
+	if (*end == '\0')
+	{
+		for (i = 0; i < sizeof(ports) / sizeof(ports[0]); i++)
+			if (ports[i].port == number)
+				return number;
+	}
+	else
+		for (i = 0; i < sizeof(ports) / sizeof(ports[0]); i++)
+			if (strcmp(ports[i].name, name) == 0)
+				return ports[i].port;
+	fail("not a mechanism motor port");
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	FILE *in;
+	char text[256];
+	int last = -1;
+	int i;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: vmasm routine.txt\n");
+		return 2;
+	}
+	input = argv[1];
+	in = fopen(input, "r");
+	if (in == NULL)
+	{
+		perror(input);
+		return 1;
+	}
+	while (fgets(text, sizeof(text), in) != NULL)
+	{
+		char word[64];
+		char arg[64];
+		char *comment = strchr(text, '#');
+		char *body = text;
+		char *colon;
+		double a, b, c;
+
+		line++;
+		if (comment != NULL)
+			*comment = '\0';
+		colon = strchr(text, ':');
+		if (colon != NULL)
+		{
+			Label *l;
+
+			*colon = '\0';
+			if (sscanf(text, "%63s", word) != 1)
+				fail("missing label name");
+			l = label(word);
+			if (l->address >= 0)
+				fail("label defined twice");
+			l->address = length;
+			body = colon + 1;
+		}
+		if (sscanf(body, "%63s", word) != 1)
+			continue;
+		last = length;
+		if (strcmp(word, "limits") == 0 && sscanf(body, "%*s %lf %lf", &a, &b) == 2)
+		{
+			emit(VM_LIMITS, 1, 0, 255);
+			emit(lround(a), 2, 1, 65535);
+			emit(lround(b), 2, 1, 65535);
+		}
+		else if (strcmp(word, "drive") == 0 && sscanf(body, "%*s %lf", &a) == 1)
+		{
+			emit(VM_DRIVE, 1, 0, 255);
+			emit(lround(a * TICKS_PER_INCH), 2, -32767, 32767);
+		}
+		else if (strcmp(word, "strafe") == 0 && sscanf(body, "%*s %lf", &a) == 1)
+		{
+			emit(VM_STRAFE, 1, 0, 255);
+			emit(lround(a * TICKS_PER_INCH), 2, -32767, 32767);
+		}
+		else if (strcmp(word, "turn") == 0 && sscanf(body, "%*s %lf", &a) == 1)
+		{
+			emit(VM_TURN, 1, 0, 255);
+			emit(lround(a * TICKS_PER_DEGREE), 2, -32767, 32767);
+		}
+		else if (strcmp(word, "motor") == 0 && sscanf(body, "%*s %63s %lf", arg, &a) == 2)
+		{
+			emit(VM_MOTOR, 1, 0, 255);
+			emit(port(arg), 1, 1, 10);
+			emit(lround(a), 1, -127, 127);
+		}
+		else if (strcmp(word, "wait") == 0 && sscanf(body, "%*s %lf", &a) == 1)
+		{
+			emit(VM_WAIT, 1, 0, 255);
+			emit(lround(a), 2, 0, 65535);
+		}
+		else if (strcmp(word, "waitpin") == 0 &&
+			sscanf(body, "%*s %lf %63s %lf", &a, arg, &c) == 3 &&
+			(strcmp(arg, "high") == 0 || strcmp(arg, "low") == 0))
+		{
+			emit(VM_WAITPIN, 1, 0, 255);
+			emit(lround(a), 1, 1, 12);
+			emit(strcmp(arg, "high") == 0, 1, 0, 1);
+			emit(lround(c), 2, 0, 65535);
+		}
+		else if ((strcmp(word, "waitabove") == 0 || strcmp(word, "waitbelow") == 0) &&
+			sscanf(body, "%*s %lf %lf %lf", &a, &b, &c) == 3)
+		{
+			emit(strcmp(word, "waitabove") == 0 ? VM_WAITABOVE : VM_WAITBELOW, 1, 0, 255);
+			emit(lround(a), 1, 1, 8);
+			emit(lround(b), 2, 0, 4095);
+			emit(lround(c), 2, 0, 65535);
+		}
+		else if (strcmp(word, "parallel") == 0 && sscanf(body, "%*s %63s", arg) == 1)
+		{
+			if (fixupCount >= MAX_LABELS)
+				fail("too many parallels");
+			emit(VM_PARALLEL, 1, 0, 255);
+			fixups[fixupCount].label = label(arg);
+			fixups[fixupCount].address = length;
+			fixups[fixupCount++].line = line;
+			emit(0, 2, 0, 0);
+		}
+		else if (strcmp(word, "join") == 0)
+			emit(VM_JOIN, 1, 0, 255);
+		else if (strcmp(word, "end") == 0)
+			emit(VM_END, 1, 0, 255);
+		else
+			fail("cannot parse instruction");
+		lines[last] = line;
+	}
+	fclose(in);
+
+	if (last < 0 || program[last] != VM_END)
+		fail("the last instruction must be end");
+	for (i = 0; i < fixupCount; i++)
+	{
+		int address = fixups[i].label->address;
+
+		line = fixups[i].line;
+		if (address < 0 || address >= length)
+			fail("parallel to an undefined label");
+		// Threads only start forward, so every thread reaches the final end
+		if (address <= fixups[i].address)
+			fail("parallel to an earlier label");
+		program[fixups[i].address] = (unsigned char)(address & 0xFF);
+		program[fixups[i].address + 1] = (unsigned char)(address >> 8);
+		// The thread runs to the next end, and two threads joining would wait on each other
+		for (; lines[address] == 0 || program[address] != VM_END; address++)
+			if (lines[address] != 0 && program[address] == VM_JOIN)
+			{
+				line = lines[address];
+				fail("join in a thread started by parallel");
+			}
+	}
+
+	fwrite(VM_MAGIC, 1, 4, stdout);
+	putchar(length & 0xFF);
+	putchar(length >> 8);
+	fwrite(program, 1, length, stdout);
+	return 0;
+}